@@ -0,0 +1,423 @@
+//! @file
+//! @brief Benchmark - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @version 1.0
+//! @date 2021
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2021, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "options.hpp"
+#include "suboptions.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+//============================================
+//! Licznik alokacji wykonanych przez operator new.
+static std::atomic<unsigned long> allocations(0);
+//! Licznik bajtów przydzielonych przez operator new.
+static std::atomic<unsigned long> allocatedBytes(0);
+//! 
+//! @brief Przydziela pamięć dla operator new i zlicza alokację.
+//! 
+//! Funkcje allocate() i release() nie są rozwijane w miejscu wywołania - kompilator nie widzi wtedy malloc()/free() 
+//! w parze z new/delete (brak ostrzeżeń -Wmismatched-new-delete).
+//! 
+__attribute__((noinline)) static void * allocate(std::size_t size){
+    allocations.fetch_add(1,std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size,std::memory_order_relaxed);
+    if (void * ptr=std::malloc(size?size:1)) return(ptr);
+    throw std::bad_alloc();
+}
+//! Zwalnia pamięć przydzieloną przez allocate().
+__attribute__((noinline)) static void release(void * ptr) noexcept {
+    std::free(ptr);
+}
+void * operator new(std::size_t size){
+    return(allocate(size));
+}
+void * operator new[](std::size_t size){
+    return(allocate(size));
+}
+void operator delete(void * ptr) noexcept {
+    release(ptr);
+}
+void operator delete[](void * ptr) noexcept {
+    release(ptr);
+}
+void operator delete(void * ptr,std::size_t) noexcept {
+    release(ptr);
+}
+void operator delete[](void * ptr,std::size_t) noexcept {
+    release(ptr);
+}
+//============================================
+namespace bench {
+//============================================
+typedef std::vector<std::string> args_t;
+typedef std::chrono::steady_clock steady_t;
+//! Wynik pojedynczego pomiaru.
+struct result_t {
+    //! Czas w nanosekundach na jednostkę (argument, opcję, subopcję).
+    double ns=0;
+    //! Liczba alokacji na jednostkę.
+    double allocs=0;
+    //! Liczba przydzielonych bajtów na jednostkę (bez odejmowania zwolnionych).
+    double bytes=0;
+};
+//! Znaki, które mogą być krótkimi nazwami opcji.
+static const std::string shortNames("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789");
+//! Rodzaje opcji używanych w teście.
+enum kind_t {kind_counter=0,kind_single_int,kind_vector_int,kind_single_string,kind_count};
+//! Limit pracy (liczba opcji * liczba argumentów), powyżej którego przypadek jest pomijany.
+static double maxWork=1e9;
+//! Liczba zarejestrowanych opcji.
+static std::size_t registered=0;
+//! Orientacyjna liczba jednostek (argumentów, opcji) przetwarzanych w jednym pomiarze.
+static const double budget=200000;
+//! Prosty generator liczb pseudolosowych (powtarzalne wyniki).
+static unsigned long nextRandom(){
+    static unsigned long state=88172645463325252UL;
+    state^=state<<13;
+    state^=state>>7;
+    state^=state<<17;
+    return(state);
+}
+//!
+//! @brief Rejestruje opcje w kontekście domyślnym tak, aby łącznie było ich zarejestrowanych count.
+//!
+//! Opcje nie są zwalniane (ani wyrejestrowywane) - rejestr kontekstu domyślnego rośnie z kolejnymi pomiarami.
+//!
+static void registerOptions(std::size_t count){
+    for (;registered<count;registered++){
+        std::string name("opt-"+std::to_string(registered));
+        switch (registered%kind_count){
+            case kind_counter:
+                new ict::options::counter(shortNames,name,"","Licznik.");
+                break;
+            case kind_single_int:
+                new ict::options::single<int>(shortNames,name,"1","Liczba.");
+                break;
+            case kind_vector_int:
+                new ict::options::vector<int>(shortNames,name,"1\n2","Lista liczb.");
+                break;
+            default:
+                new ict::options::single<std::string>(shortNames,name,"","Tekst.");
+                break;
+        }
+    }
+}
+//!
+//! @brief Generuje argumenty dla funkcji process().
+//!
+//! @param options Liczba opcji, z których losowane są argumenty.
+//! @param argc Docelowa liczba argumentów.
+//! @param shortPercent Procent opcji podawanych w krótkiej formie.
+//! @param args Wygenerowane argumenty.
+//!
+static void generate(std::size_t options,std::size_t argc,unsigned int shortPercent,args_t & args){
+    args.clear();
+    args.reserve(argc+1);
+    args.emplace_back("bench");
+    while (args.size()<argc){
+        std::size_t k=nextRandom()%options;
+        bool useShort=(k<shortNames.size())&&((nextRandom()%100)<shortPercent);
+        std::string value;
+        switch (k%kind_count){
+            case kind_counter:break;
+            case kind_single_int:case kind_vector_int:
+                value=std::to_string(nextRandom()%100000);
+                break;
+            default:
+                value="value-"+std::to_string(k);
+                break;
+        }
+        if (useShort){
+            args.emplace_back(std::string("-")+shortNames.at(k));
+            if (!value.empty()) args.emplace_back(value);
+        } else {
+            std::string arg("--opt-"+std::to_string(k));
+            if (!value.empty()) arg+="="+value;
+            args.emplace_back(arg);
+        }
+    }
+}
+//!
+//! @brief Mierzy czas wykonania funkcji process() dla zadanych argumentów.
+//!
+//! @param p Kontekst parsera.
+//! @param options Liczba opcji zarejestrowanych w kontekście parsera.
+//! @param args Argumenty.
+//! @param result Wynik pomiaru (na argument).
+//! @return Wynik funkcji process().
+//!
+static int measureProcess(ict::options::parser & p,std::size_t options,args_t & args,result_t & result){
+    std::vector<char*> argv;
+    std::size_t reps=1+budget/(args.size()+options);
+    int out=0;
+    for (std::string & s : args) argv.push_back(&s[0]);
+    argv.push_back(nullptr);
+    out=p.process(argv.size()-1,argv.data());//Rozgrzewka.
+    {
+        unsigned long a=allocations.load();
+        unsigned long b=allocatedBytes.load();
+        steady_t::time_point start=steady_t::now();
+        for (std::size_t k=0;k<reps;k++) out=p.process(argv.size()-1,argv.data());
+        steady_t::time_point stop=steady_t::now();
+        double units=double(reps)*double(args.size());
+        result.ns=std::chrono::duration<double,std::nano>(stop-start).count()/units;
+        result.allocs=double(allocations.load()-a)/units;
+        result.bytes=double(allocatedBytes.load()-b)/units;
+    }
+    return(out);
+}
+//!
+//! @brief Mierzy czas wykonania funkcji help().
+//!
+//! Tekst pomocy jest zapamiętywany w kontekście parsera po pierwszym wywołaniu. W pomiarze bez pamięci podręcznej (cold) 
+//! jest ona czyszczona przed każdym wywołaniem (przez setCatalog()) - czyszczenie nie jest wliczane do wyniku.
+//!
+//! @param cold Czy pamięć podręczna tekstu pomocy ma być czyszczona przed każdym wywołaniem.
+//! @param result Wynik pomiaru (na opcję).
+//!
+static void measureHelp(bool cold,result_t & result){
+    ict::options::parser & p(ict::options::defaultParser());
+    std::size_t reps=1+budget/(10*registered);
+    std::string catalog(p.getCatalog());
+    steady_t::duration time(0);
+    unsigned long count=0;
+    unsigned long bytes=0;
+    {
+        std::ostringstream os;
+        ict::options::help(os);//Rozgrzewka.
+    }
+    for (std::size_t k=0;k<reps;k++){
+        std::ostringstream os;
+        if (cold) p.setCatalog(catalog);
+        unsigned long a=allocations.load();
+        unsigned long b=allocatedBytes.load();
+        steady_t::time_point start=steady_t::now();
+        ict::options::help(os);
+        time+=steady_t::now()-start;
+        count+=allocations.load()-a;
+        bytes+=allocatedBytes.load()-b;
+    }
+    double units=double(reps)*double(registered);
+    result.ns=std::chrono::duration<double,std::nano>(time).count()/units;
+    result.allocs=double(count)/units;
+    result.bytes=double(bytes)/units;
+}
+//! Sposoby wywołania funkcji subprocess() używane w teście.
+enum subprocess_t {
+    //! Tablica tokenów tworzona z ciągu znaków przy każdym wywołaniu, wynik w ict::options::suboptions_t.
+    subprocess_string=0,
+    //! Jedna tablica tokenów (ict::options::subtokens) dla wszystkich wywołań, wynik w ict::options::suboptions_t.
+    subprocess_table,
+    //! Jedna tablica tokenów dla wszystkich wywołań, wynik w ict::options::flat_suboptions_t.
+    subprocess_flat,
+    subprocess_count
+};
+//! Nazwy sposobów wywołania funkcji subprocess().
+static const char * const subprocessNames[subprocess_count]={"string","table","flat"};
+//!
+//! @brief Mierzy czas wykonania funkcji subprocess().
+//!
+//! @param count Liczba subopcji w ciągu znaków.
+//! @param variant Sposób wywołania funkcji subprocess().
+//! @param result Wynik pomiaru (na subopcję).
+//! @return Wynik funkcji subprocess().
+//!
+static int measureSubprocess(std::size_t count,subprocess_t variant,result_t & result){
+    std::string tokens;
+    std::string input;
+    std::size_t reps=1+budget/count;
+    int out=0;
+    for (std::size_t k=0;k<count;k++){
+        if (k){
+            tokens+=',';
+            input+=',';
+        }
+        tokens+="key"+std::to_string(k);
+        input+="key"+std::to_string(k)+"=value"+std::to_string(k);
+    }
+    {
+        ict::options::subtokens table(tokens);
+        unsigned long a=allocations.load();
+        unsigned long b=allocatedBytes.load();
+        steady_t::time_point start=steady_t::now();
+        for (std::size_t k=0;k<reps;k++){
+            switch (variant){
+                case subprocess_string:{
+                    ict::options::suboptions_t output;
+                    out=ict::options::subprocess(input,tokens,output);
+                } break;
+                case subprocess_table:{
+                    ict::options::suboptions_t output;
+                    out=ict::options::subprocess(input,table,output);
+                } break;
+                default:{
+                    ict::options::flat_suboptions_t output;
+                    out=ict::options::subprocess(input,table,output);
+                } break;
+            }
+        }
+        steady_t::time_point stop=steady_t::now();
+        double units=double(reps)*double(count);
+        result.ns=std::chrono::duration<double,std::nano>(stop-start).count()/units;
+        result.allocs=double(allocations.load()-a)/units;
+        result.bytes=double(allocatedBytes.load()-b)/units;
+    }
+    return(out);
+}
+//! Wypisuje nagłówek tabeli wyników.
+static void header(const std::string & title,const std::string & columns){
+    std::cout<<std::endl<<"# "<<title<<std::endl;
+    std::cout<<columns<<std::setw(12)<<"ns/unit"<<std::setw(14)<<"allocs/unit"<<std::setw(14)<<"bytes/unit"<<std::endl;
+}
+//! Wypisuje wynik pomiaru.
+static void print(const result_t & result){
+    std::cout<<std::fixed<<std::setprecision(2);
+    std::cout<<std::setw(12)<<result.ns<<std::setw(14)<<result.allocs<<std::setw(14)<<result.bytes<<std::endl;
+}
+//! Wynik pomiaru funkcji help() dla danej liczby opcji.
+struct helpResult_t {
+    //! Liczba zarejestrowanych opcji.
+    std::size_t options=0;
+    //! Wynik pomiaru bez pamięci podręcznej tekstu pomocy.
+    result_t cold;
+    //! Wynik pomiaru z pamięcią podręczną tekstu pomocy.
+    result_t cached;
+};
+//! Wyniki pomiarów funkcji help() (zbierane w trakcie pomiarów funkcji process()).
+static std::vector<helpResult_t> helpResults;
+//!
+//! @brief Pomiar funkcji process() w zależności od liczby opcji, liczby argumentów i rodzaju opcji.
+//!
+//! Opcje są dodawane do kontekstu domyślnego (patrz registerOptions()), dlatego przy każdej liczbie opcji mierzona jest też funkcja help().
+//!
+static void sweepProcess(){
+    static const std::size_t optionsList[]={10,100,1000,10000};
+    static const std::size_t argcList[]={10,1000,100000,1000000};
+    static const unsigned int shortList[]={0,50,100};
+    args_t args;
+    header("process() - unit: argument","options      argc  short%");
+    for (std::size_t options : optionsList){
+        registerOptions(options);
+        {
+            helpResult_t result;
+            result.options=options;
+            measureHelp(true,result.cold);
+            measureHelp(false,result.cached);
+            helpResults.push_back(result);
+        }
+        for (std::size_t argc : argcList) for (unsigned int shortPercent : shortList){
+            result_t result;
+            std::cout<<std::setw(7)<<options<<std::setw(10)<<argc<<std::setw(8)<<shortPercent;
+            if ((double(options)*double(argc))>maxWork){
+                std::cout<<"  skipped (work limit)"<<std::endl;
+                continue;
+            }
+            generate(options,argc,shortPercent,args);
+            if (measureProcess(ict::options::defaultParser(),registered,args,result)){
+                std::cout<<"  process() failed"<<std::endl;
+                continue;
+            }
+            print(result);
+        }
+    }
+}
+//! Wypisuje wyniki pomiaru funkcji help() w zależności od liczby opcji.
+static void sweepHelp(){
+    header("help() - unit: option","options    cache");
+    for (const helpResult_t & r : helpResults){
+        std::cout<<std::setw(7)<<r.options<<std::setw(9)<<"cold";
+        print(r.cold);
+        std::cout<<std::setw(7)<<r.options<<std::setw(9)<<"cached";
+        print(r.cached);
+    }
+}
+//! Pomiar funkcji process() w zależności od liczby wartości opcji typu vector<T> (we własnym kontekście parsera - bez opcji z sweepProcess()).
+static void sweepVector(){
+    static const std::size_t countList[]={10,1000,100000,1000000};
+    ict::options::parser p;
+    ict::options::vector<int> vectorInt(p,"","bench-vector-int","","Lista liczb całkowitych.");
+    ict::options::vector<double> vectorDouble(p,"","bench-vector-double","","Lista liczb zmiennoprzecinkowych.");
+    args_t args;
+    header("process() with vector<T> - unit: value","type        values");
+    for (const std::string & name : {std::string("int"),std::string("double")}) for (std::size_t count : countList){
+        result_t result;
+        args.clear();
+        args.emplace_back("bench");
+        for (std::size_t k=0;k<count;k++){
+            if (name=="int"){
+                args.emplace_back("--bench-vector-int="+std::to_string(nextRandom()%100000));
+            } else {
+                args.emplace_back("--bench-vector-double="+std::to_string(double(nextRandom()%100000)/7.0));
+            }
+        }
+        std::cout<<std::setw(6)<<name<<std::setw(14)<<count;
+        if (measureProcess(p,2,args,result)){
+            std::cout<<"  process() failed"<<std::endl;
+            continue;
+        }
+        print(result);
+    }
+}
+//! Pomiar funkcji subprocess() w zależności od długości ciągu subopcji i sposobu wywołania (patrz subprocess_t).
+static void sweepSubprocess(){
+    static const std::size_t countList[]={1,10,100,1000};
+    header("subprocess() - unit: suboption","suboptions  variant");
+    for (std::size_t count : countList) for (int variant=0;variant<subprocess_count;variant++){
+        result_t result;
+        std::cout<<std::setw(10)<<count<<std::setw(9)<<subprocessNames[variant];
+        if (measureSubprocess(count,subprocess_t(variant),result)){
+            std::cout<<"  subprocess() failed"<<std::endl;
+            continue;
+        }
+        print(result);
+    }
+}
+//============================================
+}
+//============================================
+int main(int argc,char *argv[]){
+    if (1<argc) bench::maxWork=std::atof(argv[1]);
+    std::cout<<"libict-options benchmark (work limit: "<<bench::maxWork<<")"<<std::endl;
+    bench::sweepProcess();
+    bench::sweepHelp();
+    bench::sweepVector();
+    bench::sweepSubprocess();
+    return(0);
+}
+//============================================
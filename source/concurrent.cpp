@@ -0,0 +1,117 @@
+//! @file
+//! @brief Concurrent module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @version 1.0
+//! @date 2021
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2021, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "concurrent.hpp"
+//============================================
+namespace ict { namespace  options { 
+//============================================
+//! Numer generacji.
+static std::atomic<std::uint64_t> generationCounter{0};
+std::uint64_t generation(){
+    return(generationCounter.load(std::memory_order_acquire));
+}
+void nextGeneration(){
+    generationCounter.fetch_add(1,std::memory_order_release);
+}
+//===========================================
+} }
+//===========================================
+#ifdef ENABLE_TESTING
+#include "test.hpp"
+#include "testing.hpp"
+#include <thread>
+#include <vector>
+#include <string>
+
+//! Wartość złożona z kilku słów (do sprawdzenia spójności odczytu).
+struct testPoint {
+    long x=0;
+    long y=0;
+    long z=0;
+    void clear(){
+        x=y=z=0;
+    }
+    friend std::istream & operator>>(std::istream & input,testPoint & p){
+        input>>p.x;
+        p.z=p.y=p.x;
+        return(input);
+    }
+};
+REGISTER_TEST(concurrent,tc1){
+    int out=0;
+    ict::options::parser p;
+    ict::options::concurrent<ict::options::single<int>> port(p,"p","port","80","Opis port.");
+    ict::options::concurrent<ict::options::single<double>> ratio(p,"r","ratio","","Opis ratio.");
+    std::uint64_t g;
+    if (port.version()!=0) out=101;
+    if (!out) if (testProcess(p,{"test"})) out=102;
+    if (!out) if ((port.load()!=80)||(port.version()!=1)) out=103;
+    if (!out) if ((ratio.load()!=0)||(ratio.version()!=1)) out=104;
+    g=ict::options::generation();
+    if (!out) if (testProcess(p,{"test"})) out=105;
+    if (!out) if ((port.version()!=1)||(ict::options::generation()!=g)) out=106;//Bez zmian.
+    if (!out) if (testProcess(p,{"test","-p","8080"})) out=107;
+    if (!out) if ((port.load()!=8080)||(port.version()!=2)||(ratio.version()!=1)) out=108;
+    if (!out) if (ict::options::generation()==g) out=109;
+    if (!out) if (testProcess(p,{"test","-p","1","-r","x"})!=-3) out=110;
+    if (!out) if (port.load()!=8080) out=111;//Błąd - wartość nie jest publikowana.
+    return(out);
+}
+REGISTER_TEST(concurrent,tc2){
+    std::atomic<int> out(0);
+    std::atomic<bool> done(false);
+    ict::options::parser p;
+    ict::options::concurrent<ict::options::single<testPoint>> point(p,"p","point","0","Opis point.");
+    std::vector<std::thread> readers;
+    if (testProcess(p,{"test"})) out=101;
+    for (int t=0;t<4;t++) readers.emplace_back([&](){
+        std::uint64_t last=0;
+        while ((!done)&&(!out)){
+            std::uint64_t v=point.version();
+            testPoint pt(point.load());
+            if ((pt.x!=pt.y)||(pt.y!=pt.z)) out=102;//Odczyt musi być spójny.
+            if (v<last) out=103;
+            last=v;
+        }
+    });
+    for (int k=1;(k<2000)&&(!out);k++) if (testProcess(p,{"test","-p",std::to_string(k)})) out=104;
+    done=true;
+    for (auto & t : readers) t.join();
+    if (!out) if (point.load().x!=1999) out=105;
+    return(out);
+}
+#endif
+//===========================================
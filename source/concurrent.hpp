@@ -0,0 +1,142 @@
+//! @file
+//! @brief Concurrent module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @version 1.0
+//! @date 2021
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2021, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _ICT_CONCURRENT_HEADER
+#define _ICT_CONCURRENT_HEADER
+//============================================
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "options.hpp"
+//============================================
+namespace ict { namespace  options { 
+//===========================================
+//! 
+//! @brief Zwraca numer generacji - zwiększany przy każdej zmianie opublikowanej wartości opcji ict::options::concurrent.
+//! 
+//! Pozwala tanio sprawdzić, czy coś się zmieniło (np. przed przebudową danych wyliczanych z wartości opcji).
+//! 
+//! @return Numer generacji.
+//! 
+std::uint64_t generation();
+//! 
+//! @brief Zwiększa numer generacji (patrz ict::options::generation()).
+//! 
+void nextGeneration();
+//! 
+//! @brief Opcja, której wartość może być odczytywana przez wiele wątków w trakcie jej zmiany (patrz specjalizacja dla ict::options::single).
+//! 
+template <class Option> class concurrent;
+//! 
+//! @brief Opcja z pojedynczą wartością odczytywaną współbieżnie (seqlock).
+//! 
+//! Parser zapisuje wartość w polu value (tylko dla wątku parsera), a po zakończeniu parsowania (w finish()) wartość jest publikowana.
+//! Inne wątki odczytują opublikowaną wartość przez load() - bez blokad i bez operacji typu read-modify-write. 
+//! Wartości mogą być zmieniane tylko przez jeden wątek naraz. Dla innych typów (np. std::string lub zestawów wartości) 
+//! należy użyć ict::options::reloadable.
+//! 
+//! @tparam Type Typ wartości (trywialnie kopiowalny, z konstruktorem domyślnym).
+//! 
+template <class Type> class concurrent<single<Type>> : public single<Type>{
+private:
+    static_assert(std::is_trivially_copyable<Type>::value,"ict::options::concurrent requires a trivially copyable type");
+    static_assert(std::is_default_constructible<Type>::value,"ict::options::concurrent requires a default constructible type (load() copies the published value into a new object)");
+    //! Typ słowa, w którym przechowywana jest opublikowana wartość.
+    typedef std::uintptr_t word_t;
+    //! Liczba słów opublikowanej wartości.
+    static constexpr std::size_t words=(sizeof(Type)+sizeof(word_t)-1)/sizeof(word_t);
+    //! Numer sekwencyjny (nieparzysty - trwa zapis).
+    std::atomic<std::uint64_t> sequence{0};
+    //! Opublikowana wartość.
+    std::atomic<word_t> storage[words]={};
+    //! 
+    //! @brief Publikuje wartość (jeśli się zmieniła).
+    //! 
+    void publish(){
+        word_t w[words]={};
+        bool changed=(sequence.load(std::memory_order_relaxed)==0);
+        std::uint64_t s;
+        std::memcpy(w,&this->value,sizeof(Type));
+        for (std::size_t k=0;k<words;k++) if (storage[k].load(std::memory_order_relaxed)!=w[k]) changed=true;
+        if (!changed) return;
+        s=sequence.load(std::memory_order_relaxed);
+        sequence.store(s+1,std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t k=0;k<words;k++) storage[k].store(w[k],std::memory_order_relaxed);
+        sequence.store(s+2,std::memory_order_release);
+        nextGeneration();
+    }
+public:
+    using single<Type>::single;
+    //! 
+    //! @brief Odczytuje opublikowaną wartość (spójną - nawet jeśli w tym czasie jest publikowana nowa wartość).
+    //! 
+    //! @return Wartość.
+    //! 
+    Type load() const {
+        word_t w[words];
+        Type out;
+        for (;;){
+            std::uint64_t s1=sequence.load(std::memory_order_acquire);
+            std::uint64_t s2;
+            if (s1&1) continue;
+            for (std::size_t k=0;k<words;k++) w[k]=storage[k].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            s2=sequence.load(std::memory_order_relaxed);
+            if (s1==s2) break;
+        }
+        std::memcpy(&out,w,sizeof(Type));
+        return(out);
+    }
+    //! 
+    //! @brief Zwraca wersję opublikowanej wartości (0 - wartość nie była jeszcze opublikowana).
+    //! 
+    //! @return Wersja.
+    //! 
+    std::uint64_t version() const {
+        return(sequence.load(std::memory_order_acquire)/2);
+    }
+    //! Patrz ict::options::interface::finish()
+    int finish(){
+        int out=single<Type>::finish();
+        if (!out) publish();
+        return(out);
+    }
+};
+//===========================================
+} }
+//============================================
+#endif
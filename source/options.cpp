@@ -35,10 +35,29 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **************************************************************/
 //============================================
 #include "options.hpp"
-#include <unistd.h>
 #include <map>
-#include <set>
-#include <getopt.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <string_view>
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <system_error>
+#include <thread>
+#include <chrono>
+#include <typeindex>
+#include <cxxabi.h>
+#include <cctype>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+//============================================
+extern char ** environ;
 //============================================
 namespace ict { namespace  options { 
 //============================================
@@ -47,56 +66,764 @@ namespace ict { namespace  options {
 typedef std::map<char,interface*> shortOptionMap_t;
 typedef std::map<std::string,interface*> longOptionMap_t;
 typedef std::vector<interface*> optionMap_t;
-typedef std::set<interface*> optionSet_t;
-shortOptionMap_t & getShortOptionMap(){
-    static shortOptionMap_t m;
-    return(m);
+//============================================
+typedef std::unordered_map<std::string_view,entry_t> longOptionHash_t;
+typedef std::vector<std::pair<std::string_view,entry_t>> longOptionSorted_t;
+//! Plik odpowiedzi zmapowany w pamięci.
+struct mapping_t {
+    //! Adres.
+    void * addr;
+    //! Rozmiar.
+    std::size_t size;
+};
+typedef std::vector<mapping_t> mappings_t;
+typedef std::unordered_map<std::string_view,interface*> envMap_t;
+typedef std::unordered_map<std::string,std::string> helpCache_t;
+typedef std::unordered_map<std::string_view,std::string_view> catalog_t;
+//! Zdarzenie etapu (patrz ict::options::parser::traceDump()).
+struct traceEvent_t {
+    //! Nazwa etapu.
+    const char * name;
+    //! Początek (ns od włączenia statystyk).
+    std::uint64_t start;
+    //! Czas trwania (ns).
+    std::uint64_t duration;
+};
+//! Maksymalna liczba zapisanych zdarzeń etapów.
+static const std::size_t maxTraceEvents=65536;
+//! Stan statystyk kontekstu parsera.
+struct statsState_t {
+    //! Informacja, czy statystyki są zbierane.
+    bool enabled=false;
+    //! Informacja, czy są zapisywane zdarzenia etapów.
+    bool trace=false;
+    //! Statystyki.
+    stats_t data;
+    //! Początek pomiaru (włączenie statystyk).
+    std::chrono::steady_clock::time_point origin;
+    //! Zdarzenia etapów.
+    std::vector<traceEvent_t> events;
+    //! Konwersje według typów opcji (wskazują na węzły data.conversions).
+    std::unordered_map<std::type_index,stats_t::conversion_t*> types;
+    //! 
+    //! @brief Zwraca statystyki konwersji dla typu opcji.
+    //! 
+    //! @param ptr Wskaźnik do obiektu obsługującego opcję.
+    //! @return Statystyki konwersji.
+    //! 
+    stats_t::conversion_t & conversion(const interface * ptr){
+        std::type_index t(typeid(*ptr));
+        std::unordered_map<std::type_index,stats_t::conversion_t*>::iterator it=types.find(t);
+        if (it==types.end()){
+            int status=0;
+            char * name=abi::__cxa_demangle(t.name(),nullptr,nullptr,&status);
+            it=types.emplace(t,&data.conversions[(name&&!status)?name:t.name()]).first;
+            std::free(name);
+        }
+        return(*it->second);
+    }
+    //! 
+    //! @brief Kończy przetwarzanie opcji (patrz ict::options::interface::finish()) i dolicza czas oraz błędy do konwersji jej typu.
+    //! 
+    //! Czas jest doliczany tylko dla typów, które miały już konwersje (np. wartości zapamiętane w trybie bulk()) lub w przypadku błędu.
+    //! 
+    //! @param ptr Wskaźnik do obiektu obsługującego opcję.
+    //! @return Wartość zwrócona przez finish().
+    //! 
+    int finish(interface * ptr){
+        std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+        int c=ptr->finish();
+        std::uint64_t ns=std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start).count();
+        std::unordered_map<std::type_index,stats_t::conversion_t*>::iterator it=types.find(std::type_index(typeid(*ptr)));
+        if ((it!=types.end())||c){
+            stats_t::conversion_t & t((it!=types.end())?*it->second:conversion(ptr));
+            t.ns+=ns;
+            data.conversion.ns+=ns;
+            if (c){
+                t.failures++;
+                data.failures++;
+            }
+        }
+        return(c);
+    }
+};
+//! Pomiar czasu etapu (od utworzenia do usunięcia obiektu) - tylko, jeśli statystyki są zbierane.
+class phaseTimer_t {
+private:
+    //! Stan statystyk (nullptr - statystyki nie są zbierane).
+    statsState_t * state;
+    //! Etap.
+    stats_t::phase_t * phase;
+    //! Nazwa etapu (dla zdarzeń, nullptr - zdarzenie nie jest zapisywane).
+    const char * name;
+    //! Początek pomiaru.
+    std::chrono::steady_clock::time_point start;
+public:
+    //! 
+    //! @brief Konstruktor - rozpoczyna pomiar.
+    //! 
+    //! @param s Stan statystyk.
+    //! @param p Etap.
+    //! @param n Nazwa etapu (dla zdarzeń, nullptr - zdarzenie nie jest zapisywane).
+    //! 
+    phaseTimer_t(statsState_t & s,stats_t::phase_t stats_t::*p,const char * n=nullptr):
+        state(s.enabled?&s:nullptr),phase(&(s.data.*p)),name(n){
+        if (this->state) start=std::chrono::steady_clock::now();
+    }
+    phaseTimer_t(const phaseTimer_t &)=delete;
+    phaseTimer_t & operator=(const phaseTimer_t &)=delete;
+    //! 
+    //! @brief Kończy pomiar.
+    //! 
+    //! @return Czas trwania (ns).
+    //! 
+    std::uint64_t stop(){
+        std::uint64_t ns=0;
+        if (state){
+            std::chrono::steady_clock::time_point end(std::chrono::steady_clock::now());
+            ns=std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count();
+            phase->count++;
+            phase->ns+=ns;
+            if (name&&state->trace&&(state->events.size()<maxTraceEvents)){
+                state->events.push_back(traceEvent_t{name,
+                    (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(start-state->origin).count(),ns});
+            }
+            state=nullptr;
+        }
+        return(ns);
+    }
+    //! Destruktor - kończy pomiar (jeśli nie został zakończony).
+    ~phaseTimer_t(){
+        stop();
+    }
+};
+//! Globalna tablica nazw lokalizacji (patrz ict::options::locale_id).
+struct localeTable_t {
+    //! Blokada tablicy.
+    std::mutex mutex;
+    //! Nazwy lokalizacji (indeksowane numerem - std::deque nie przenosi elementów).
+    std::deque<std::string> names;
+    //! Numery lokalizacji (klucze wskazują na names).
+    std::unordered_map<std::string_view,std::uint32_t> ids;
+    //! Konstruktor - lokalizacja 0 to domyślna (pusta nazwa).
+    localeTable_t(){
+        names.emplace_back();
+        ids.emplace(names.back(),0);
+    }
+};
+//! Zwraca globalną tablicę nazw lokalizacji.
+static localeTable_t & localeTable(){
+    static localeTable_t table;
+    return(table);
+}
+//! Maksymalne zagnieżdżenie plików odpowiedzi.
+static const std::size_t maxResponseDepth=32;
+//! Skompilowana tablica opcji - budowana raz po rejestracji opcji i unieważniana przy rejestracji nowej opcji.
+struct compiled_t : public lookup {
+    //! Informacja, czy tablica jest aktualna.
+    bool valid=false;
+    //! Krótkie opcje (indeksowane znakiem).
+    entry_t shortOptions[256];
+    //! Długie opcje (tablica haszująca - wyszukiwanie dokładnej nazwy).
+    longOptionHash_t longOptions;
+    //! Długie opcje (posortowane - wyszukiwanie skrótów nazw).
+    longOptionSorted_t longOptionsSorted;
+    //! Patrz ict::options::lookup::findShort()
+    entry_t findShort(char c) const {
+        return(shortOptions[(unsigned char)c]);
+    }
+    //! Patrz ict::options::lookup::findLong()
+    entry_t findLong(const std::string_view & name) const;
+    //! Patrz ict::options::lookup::findExact()
+    entry_t findExact(const std::string_view & name) const {
+        longOptionHash_t::const_iterator it=longOptions.find(name);
+        return((it!=longOptions.cend())?it->second:entry_t());
+    }
+    //! Opcje w kolejności rejestracji (optionMap kontekstu parsera).
+    const optionMap_t * options=nullptr;
+    //! Patrz ict::options::lookup::optionCount()
+    std::size_t optionCount() const {
+        return(options->size());
+    }
+    //! Patrz ict::options::lookup::optionAt()
+    interface * optionAt(std::size_t k) const {
+        return((*options)[k]);
+    }
+};
+//! Dane rejestru opcji w kontekście parsera.
+struct parser::registry_t {
+    //! Krótkie nazwy opcji.
+    shortOptionMap_t shortOptionMap;
+    //! Długie nazwy opcji.
+    longOptionMap_t longOptionMap;
+    //! Opcje w kolejności rejestracji.
+    optionMap_t optionMap;
+    //! Argumenty, które nie są opcjami.
+    notOption_t notOption;
+    //! Argumenty, które nie są opcjami (widoki).
+    notOptionView_t notOptionView;
+    //! Sposób przechowywania argumentów, które nie są opcjami.
+    store_t store=store_all;
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param resource Zasób pamięci kontekstu parsera.
+    //! 
+    registry_t(std::pmr::memory_resource * resource):notOptionView(resource){
+        compiled.options=&optionMap;
+    }
+    //! Destruktor - zwalnia zmapowane pliki odpowiedzi.
+    ~registry_t(){
+        release();
+    }
+    //! Informacja, czy argumenty '@plik' są zastępowane zawartością pliku odpowiedzi.
+    bool responseFiles=false;
+    //! Pliki odpowiedzi zmapowane w pamięci (na nie wskazują widoki argumentów).
+    mappings_t mappings;
+    //! Plik konfiguracyjny (pusty - brak).
+    std::string configFile;
+    //! Katalog opisów opcji (pusty - brak).
+    std::string catalog;
+    //! Przedrostek nazw zmiennych środowiskowych.
+    std::string envPrefix;
+    //! Nazwy zmiennych środowiskowych (w kolejności opcji w tablicy opcji).
+    std::vector<std::string> envNames;
+    //! Zmienne środowiskowe powiązane z opcjami (klucze wskazują na envNames).
+    envMap_t envMap;
+    //! Informacja, czy envMap jest aktualna (tylko dla tablicy opcji tego kontekstu - compiled).
+    bool envValid=false;
+    //! Funkcja zwrotna dla argumentów, które nie są opcjami.
+    callback_t noOptionCallback;
+    //! Funkcja zwrotna dla opcji.
+    callback_t optionCallback;
+    //! Funkcja zwrotna wywoływana po zakończeniu parsowania.
+    callback_t endCallback;
+    //! Zwalnia zmapowane pliki odpowiedzi.
+    void release(){
+        for (const mapping_t & m : mappings) munmap(m.addr,m.size);
+        mappings.clear();
+    }
+    //! Skompilowana tablica opcji.
+    compiled_t compiled;
+    //! Teksty pomocy (dla lokalizacji) - usuwane przy zmianie rejestru opcji.
+    helpCache_t helpCache;
+    //! Blokada tekstów pomocy (helpText() może być wywoływana jednocześnie dla stałego kontekstu).
+    std::mutex helpMutex;
+    //! Liczba opcji (z początku optionMap), którym przydzielono nazwy (patrz ict::options::parser::finalize()).
+    std::size_t resolved=0;
+    //! Numer, od którego jest szukana kolejna nazwa 'param-N' dla opcji bez wolnej nazwy (cofany przy usunięciu opcji z taką nazwą).
+    unsigned int paramNext=1;
+    //! Statystyki.
+    statsState_t stats;
+};
+//============================================
+//! 
+//! @brief Zwraca rodzaj argumentu dla danej opcji.
+//! 
+//! @param ptr Wskaźnik do obiektu obsługującego opcję.
+//! @return Rodzaj argumentu.
+//! 
+static argument_t getArgument(interface * ptr){
+    if (ptr->getKind()==kind_counter) return(argument_none);//Brak parametru
+    if (ptr->isValueRequired()) return(argument_required);//Parametr obowiązkowy
+    return(argument_optional);//Parametr nieobowiązkowy
 }
-longOptionMap_t & getLongOptionMap(){
-    static longOptionMap_t m;
-    return(m);
+//! 
+//! @brief Buduje skompilowaną tablicę opcji (jeśli nie jest aktualna).
+//! 
+//! @param shortOptionMap Krótkie nazwy opcji.
+//! @param longOptionMap Długie nazwy opcji.
+//! @param c Skompilowana tablica opcji.
+//! 
+static void compile(const shortOptionMap_t & shortOptionMap,const longOptionMap_t & longOptionMap,compiled_t & c){
+    if (c.valid) return;
+    for (entry_t & e : c.shortOptions) e=entry_t();
+    c.longOptions.clear();
+    c.longOptionsSorted.clear();
+    for (shortOptionMap_t::const_iterator it=shortOptionMap.cbegin();it!=shortOptionMap.cend();++it){
+        c.shortOptions[(unsigned char)it->first]=entry_t{it->second,getArgument(it->second)};
+    }
+    c.longOptions.reserve(longOptionMap.size());
+    c.longOptionsSorted.reserve(longOptionMap.size());
+    for (longOptionMap_t::const_iterator it=longOptionMap.cbegin();it!=longOptionMap.cend();++it){
+        entry_t e{it->second,getArgument(it->second)};
+        c.longOptions.emplace(it->first,e);
+        c.longOptionsSorted.emplace_back(it->first,e);
+    }
+    c.valid=true;
 }
-optionMap_t & getOptionMap(){
-    static optionMap_t m;
-    return(m);
+//! 
+//! @brief Patrz ict::options::lookup::findLong()
+//! 
+//! Najpierw wyszukiwana jest dokładna nazwa, a następnie jednoznaczny skrót nazwy (jak w getopt_long()).
+//! Jeśli skrót pasuje do nazw różnych opcji, to zwracany jest brak opcji.
+//! 
+entry_t compiled_t::findLong(const std::string_view & name) const {
+    longOptionHash_t::const_iterator it=longOptions.find(name);
+    if (it!=longOptions.cend()) return(it->second);
+    {
+        entry_t out;
+        longOptionSorted_t::const_iterator i=std::lower_bound(
+            longOptionsSorted.cbegin(),longOptionsSorted.cend(),name,
+            [](const longOptionSorted_t::value_type & e,const std::string_view & n){return(e.first<n);}
+        );
+        for (;(i!=longOptionsSorted.cend())&&(i->first.substr(0,name.size())==name);++i){
+            if (out.ptr&&(out.ptr!=i->second.ptr)) return(entry_t());//Niejednoznaczny skrót.
+            out=i->second;
+        }
+        return(out);
+    }
 }
-notOption_t & getNotOption(){
-    static notOption_t m;
-    return(m);
+//! 
+//! @brief Mapuje plik w pamięci (prywatnie - zmiany nie są zapisywane w pliku).
+//! 
+//! @param path Ścieżka do pliku.
+//! @param writable Informacja, czy zmapowana pamięć może być modyfikowana.
+//! @param mappings Zmapowane pliki (mapowanie jest do nich dodawane).
+//! @param begin Początek pliku.
+//! @param end Koniec pliku.
+//! @return Jeśli: 0 - sukces (również pusty plik), -4 - błąd.
+//! 
+static int mapFile(const std::string & path,bool writable,mappings_t & mappings,char *& begin,char *& end){
+    struct stat st;
+    void * addr;
+    int fd;
+    begin=end=nullptr;
+    fd=::open(path.c_str(),O_RDONLY|O_CLOEXEC);
+    if (fd<0) return(-4);
+    if (fstat(fd,&st)){
+        ::close(fd);
+        return(-4);
+    }
+    if (st.st_size==0){
+        ::close(fd);
+        return(0);
+    }
+    addr=mmap(nullptr,st.st_size,writable?(PROT_READ|PROT_WRITE):PROT_READ,MAP_PRIVATE,fd,0);
+    ::close(fd);
+    if (addr==MAP_FAILED) return(-4);
+    mappings.push_back(mapping_t{addr,(std::size_t)st.st_size});
+    begin=(char*)addr;
+    end=begin+st.st_size;
+    return(0);
+}
+//! 
+//! @brief Usuwa białe znaki z początku i końca tekstu.
+//! 
+//! @param s Tekst.
+//! @return Tekst bez białych znaków na początku i na końcu.
+//! 
+static std::string_view trim(std::string_view s){
+    while ((!s.empty())&&std::isspace((unsigned char)s.front())) s.remove_prefix(1);
+    while ((!s.empty())&&std::isspace((unsigned char)s.back())) s.remove_suffix(1);
+    return(s);
+}
+//! 
+//! @brief Wyszukuje kolejny argument w pliku odpowiedzi i usuwa z niego cudzysłowy (w miejscu).
+//! 
+//! Argumenty są rozdzielone białymi znakami. Tekst w apostrofach jest brany dosłownie, w cudzysłowach i poza nimi
+//! znak '\\' poprzedza znak brany dosłownie. Pamięć jest modyfikowana tylko, gdy argument zawiera cudzysłowy lub znaki '\\'.
+//! 
+//! @param r Pozycja w pliku (przesuwana za argument).
+//! @param end Koniec pliku.
+//! @param out Argument.
+//! @return Informacja, czy argument został znaleziony.
+//! 
+static bool responseToken(char *& r,char * end,std::string_view & out){
+    char * start;
+    char * w;
+    char quote=0;
+    while ((r<end)&&std::isspace((unsigned char)*r)) r++;
+    if (r>=end) return(false);
+    start=w=r;
+    for (;r<end;r++){
+        char c=*r;
+        if (quote){
+            if (c==quote){
+                quote=0;
+                continue;
+            }
+            if ((quote=='"')&&(c=='\\')&&(r+1<end)) c=*++r;
+        } else {
+            if (std::isspace((unsigned char)c)) break;
+            if ((c=='\'')||(c=='"')){
+                quote=c;
+                continue;
+            }
+            if ((c=='\\')&&(r+1<end)) c=*++r;
+        }
+        if (w!=r) *w=c;//Zapis tylko w razie potrzeby (strony zmapowane prywatnie są kopiowane przy zapisie).
+        w++;
+    }
+    out=std::string_view(start,w-start);
+    return(true);
+}
+//! Źródło kolejnych argumentów - argumenty funkcji main i (opcjonalnie) zagnieżdżone pliki odpowiedzi.
+class arguments_t {
+private:
+    //! Liczba argumentów.
+    int argc;
+    //! Argumenty.
+    char * const * argv;
+    //! Indeks kolejnego argumentu.
+    int k=1;
+    //! Informacja, czy argumenty '@plik' są zastępowane zawartością pliku.
+    bool expand;
+    //! Stos otwartych plików odpowiedzi (pozycja i koniec pliku).
+    std::vector<std::pair<char*,char*>> files;
+    //! Zmapowane pliki odpowiedzi.
+    mappings_t & mappings;
+    //! 
+    //! @brief Mapuje plik odpowiedzi i umieszcza go na stosie.
+    //! 
+    //! @param path Ścieżka do pliku.
+    //! @return Jeśli: 0 - sukces, -4 - błąd.
+    //! 
+    int open(const std::string_view & path){
+        char * begin;
+        char * end;
+        if (files.size()>=maxResponseDepth) return(-4);
+        if (mapFile(std::string(path),true,mappings,begin,end)) return(-4);
+        if (begin!=end) files.emplace_back(begin,end);
+        return(0);
+    }
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param argc Liczba argumentów.
+    //! @param argv Argumenty.
+    //! @param expand Informacja, czy argumenty '@plik' są zastępowane zawartością pliku.
+    //! @param mappings Zmapowane pliki odpowiedzi.
+    //! 
+    arguments_t(int argc,char * const argv[],bool expand,mappings_t & mappings):argc(argc),argv(argv),expand(expand),mappings(mappings){}
+    //! 
+    //! @brief Pobiera kolejny argument.
+    //! 
+    //! @param out Argument.
+    //! @return Jeśli: 1 - argument pobrany, 0 - brak argumentów, -4 - błąd pliku odpowiedzi.
+    //! 
+    int next(std::string_view & out){
+        for (;;){
+            if (!files.empty()){
+                if (!responseToken(files.back().first,files.back().second,out)){
+                    files.pop_back();
+                    continue;
+                }
+            } else if (k<argc){
+                out=argv[k++];
+            } else {
+                return(0);
+            }
+            if (expand&&(out.size()>1)&&(out[0]=='@')){
+                if (open(out.substr(1))) return(-4);
+                continue;
+            }
+            return(1);
+        }
+    }
+};
+//! 
+//! @brief Wczytuje opisy opcji dla danej lokalizacji z katalogu.
+//! 
+//! @param begin Początek katalogu.
+//! @param end Koniec katalogu.
+//! @param locale Lokalizacja.
+//! @param out Opisy (długa nazwa opcji - opis, wskazują na katalog).
+//! @return Informacja, czy katalog zawiera sekcję dla tej lokalizacji (dla domyślnej lokalizacji zawsze).
+//! 
+static bool loadCatalog(const char * begin,const char * end,const std::string & locale,catalog_t & out){
+    bool inside=locale.empty();
+    bool found=inside;
+    while (begin<end){
+        const char * eol=(const char*)std::memchr(begin,'\n',end-begin);
+        std::string_view line;
+        std::size_t eq;
+        if (!eol) eol=end;
+        line=trim(std::string_view(begin,eol-begin));
+        begin=(eol<end)?(eol+1):end;
+        if (line.empty()||(line.front()=='#')||(line.front()==';')) continue;//Komentarz.
+        if ((line.front()=='[')&&(line.back()==']')){//Sekcja - lokalizacja.
+            inside=(trim(line.substr(1,line.size()-2))==locale);
+            if (inside) found=true;
+            continue;
+        }
+        if (!inside) continue;
+        eq=line.find('=');
+        if (eq!=std::string_view::npos){
+            std::string_view desc(trim(line.substr(eq+1)));
+            if ((desc.size()>=2)&&(desc.front()=='"')&&(desc.back()=='"')) desc=desc.substr(1,desc.size()-2);
+            out[trim(line.substr(0,eq))]=desc;
+        }
+    }
+    return(found);
 }
 //============================================
-void interface::registerOpt(interface*ptr){
-    if (ptr){
-        bool found=false;
+locale_id::locale_id(const std::string_view & name){
+    if (!name.empty()){
+        localeTable_t & table(localeTable());
+        std::lock_guard<std::mutex> lock(table.mutex);
+        std::unordered_map<std::string_view,std::uint32_t>::const_iterator it=table.ids.find(name);
+        if (it==table.ids.cend()){
+            table.names.emplace_back(name);
+            it=table.ids.emplace(table.names.back(),(std::uint32_t)(table.names.size()-1)).first;
+        }
+        id=it->second;
+    }
+}
+bool locale_id::find(const std::string_view & name,locale_id & out){
+    localeTable_t & table(localeTable());
+    std::lock_guard<std::mutex> lock(table.mutex);
+    std::unordered_map<std::string_view,std::uint32_t>::const_iterator it=table.ids.find(name);
+    if (it==table.ids.cend()) return(false);
+    out.id=it->second;
+    return(true);
+}
+const std::string & locale_id::name() const {
+    localeTable_t & table(localeTable());
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return(table.names[id]);
+}
+//============================================
+parser::parser(std::pmr::memory_resource * resource):resource(resource),registry(new registry_t(resource)){}
+parser::~parser(){
+    for (interface * ptr : registry->optionMap) ptr->owner=nullptr;
+}
+void parser::registerOpt(interface*ptr){
+    if (ptr){//Nazwy są przydzielane później - patrz finalize().
+        ptr->owner=this;
+        registry->optionMap.push_back(ptr);
+    }
+}
+void parser::finalize(){
+    registry_t & r(*registry);
+    if (r.resolved<r.optionMap.size()){
+        phaseTimer_t timer(r.stats,&stats_t::registration,"registration");
+        bool shortTaken[256]={};
+        std::unordered_set<std::string_view> longTaken;
+        std::vector<std::pair<std::string_view,interface*>> longNames;
         tokens_t tokens;
-        getOptionMap().push_back(ptr);
-        for (const char & c : ptr->getShortOption()) if (std::isalnum(c)){
-            if (!getShortOptionMap().count(c)){
-                getShortOptionMap()[c]=ptr;
-                found=true;
-                break;
+        std::string s;
+        for (shortOptionMap_t::const_iterator it=r.shortOptionMap.cbegin();it!=r.shortOptionMap.cend();++it) shortTaken[(unsigned char)it->first]=true;
+        longTaken.reserve(r.longOptionMap.size()+r.optionMap.size()-r.resolved);
+        for (longOptionMap_t::const_iterator it=r.longOptionMap.cbegin();it!=r.longOptionMap.cend();++it) longTaken.insert(it->first);
+        longNames.reserve(r.optionMap.size()-r.resolved);
+        //Nazwy są przydzielane w kolejności rejestracji (pierwsza wolna nazwa z listy).
+        for (std::size_t k=r.resolved;k<r.optionMap.size();k++){
+            interface * ptr=r.optionMap[k];
+            bool found=false;
+            for (const char & c : ptr->getShortOption()) if (std::isalnum(c)){
+                if (!shortTaken[(unsigned char)c]){
+                    shortTaken[(unsigned char)c]=true;
+                    r.shortOptionMap.emplace_hint(r.shortOptionMap.end(),c,ptr);
+                    ptr->shortName=c;
+                    found=true;
+                    break;
+                }
+            }
+            tokens.clear();
+            tokenizer(ptr->getLongOption(),tokens);
+            for (const std::string & t : tokens) {
+                if (!longTaken.count(t)){
+                    ptr->longName=t;
+                    found=true;
+                    break;
+                }
+            }
+            if (!found) for(;r.paramNext<1000;r.paramNext++){
+                s.assign("param-");
+                s+=std::to_string(r.paramNext);
+                if (!longTaken.count(s)){
+                    ptr->longName=s;
+                    r.paramNext++;
+                    found=true;
+                    break;
+                }
+            }
+            if (!ptr->longName.empty()){//Klucze wskazują na nazwy w opcjach.
+                longTaken.insert(ptr->longName);
+                longNames.emplace_back(ptr->longName,ptr);
             }
         }
-        tokenizer(ptr->getLongOption(),tokens);
-        for (const std::string & t : tokens) {
-            if (!getLongOptionMap().count(t)){
-                getLongOptionMap()[t]=ptr;
-                found=true;
-                break;
+        //Nowe długie nazwy są wstawiane posortowane - z podpowiedzią pozycji (za poprzednio wstawioną nazwą).
+        std::sort(longNames.begin(),longNames.end());
+        if (!longNames.empty()){
+            longOptionMap_t::iterator hint=r.longOptionMap.lower_bound(std::string(longNames.front().first));
+            for (const auto & n : longNames) hint=std::next(r.longOptionMap.emplace_hint(hint,std::string(n.first),n.second));
+        }
+        r.resolved=r.optionMap.size();
+        r.compiled.valid=false;
+        r.envValid=false;
+        r.helpCache.clear();
+    }
+}
+void parser::unregisterOpt(interface*ptr){
+    if (ptr){
+        //Opcje są zwykle usuwane w odwrotnej kolejności niż były tworzone - szukanie od końca.
+        optionMap_t::reverse_iterator it=std::find(registry->optionMap.rbegin(),registry->optionMap.rend(),ptr);
+        if (it!=registry->optionMap.rend()){
+            optionMap_t::iterator i=std::next(it).base();
+            if ((std::size_t)(i-registry->optionMap.begin())<registry->resolved) registry->resolved--;
+            registry->optionMap.erase(i);
+        }
+        if (ptr->shortName){
+            shortOptionMap_t::iterator i=registry->shortOptionMap.find(ptr->shortName);
+            if ((i!=registry->shortOptionMap.end())&&(i->second==ptr)) registry->shortOptionMap.erase(i);
+        }
+        if (!ptr->longName.empty()){
+            longOptionMap_t::iterator i=registry->longOptionMap.find(ptr->longName);
+            if ((i!=registry->longOptionMap.end())&&(i->second==ptr)){
+                static const std::string_view prefix("param-");
+                const std::string & name(i->first);
+                unsigned int n=0;
+                //Zwolniona nazwa 'param-N' może zostać przydzielona ponownie - szukanie zaczyna się od najniższej zwolnionej.
+                if ((name.size()>prefix.size())&&(name.compare(0,prefix.size(),prefix)==0)){
+                    const char * end=name.data()+name.size();
+                    std::from_chars_result c=std::from_chars(name.data()+prefix.size(),end,n);
+                    if ((c.ec==std::errc())&&(c.ptr==end)&&n&&(n<registry->paramNext)) registry->paramNext=n;
+                }
+                registry->longOptionMap.erase(i);
             }
         }
-        if (!found) for(unsigned int k=1;k<1000;k++){
-            std::string s("param-");
-            s+=std::to_string(k);
-            if (!getLongOptionMap().count(s)){
-                getLongOptionMap()[s]=ptr;
-                found=true;
+        registry->compiled.valid=false;
+        registry->envValid=false;
+        registry->helpCache.clear();
+        ptr->owner=nullptr;
+    }
+}
+parser & defaultParser(){
+    static parser p;
+    return(p);
+}
+int parser::set(interface * ptr,source_t source,const std::string_view & val){
+    if (ptr->source<source){//Wartości z mniej ważnego źródła są zastępowane.
+        if (ptr->source!=source_default) ptr->clear();
+        ptr->source=source;
+    }
+    if (registry->stats.enabled){
+        phaseTimer_t timer(registry->stats,&stats_t::conversion);
+        int c=ptr->setValue(val);
+        stats_t::conversion_t & t(registry->stats.conversion(ptr));
+        t.count++;
+        t.ns+=timer.stop();
+        if (c!=0){
+            t.failures++;
+            registry->stats.data.failures++;
+            return(-3);
+        }
+    } else if (ptr->setValue(val)!=0) return(-3);
+    return(registry->optionCallback?registry->optionCallback(ptr,val):0);
+}
+int parser::loadConfig(const lookup & table){
+    char * p;
+    char * end;
+    std::string prefix;
+    std::string key;
+    int c=mapFile(registry->configFile,false,registry->mappings,p,end);
+    if (c) return(c);
+    while (p<end){
+        char * eol=(char*)std::memchr(p,'\n',end-p);
+        std::string_view line;
+        std::string_view name;
+        std::string_view val;
+        std::size_t eq;
+        entry_t e;
+        if (!eol) eol=end;
+        line=trim(std::string_view(p,eol-p));
+        p=(eol<end)?(eol+1):end;
+        if (line.empty()||(line.front()=='#')||(line.front()==';')) continue;//Komentarz.
+        if (line.front()=='['){//Sekcja - przedrostek nazw opcji.
+            if (line.back()!=']') return(-1);
+            prefix.assign(trim(line.substr(1,line.size()-2)));
+            if (!prefix.empty()) prefix+='-';
+            continue;
+        }
+        eq=line.find('=');
+        name=trim(line.substr(0,eq));
+        if (name.empty()) return(-1);
+        if (eq!=std::string_view::npos){
+            val=trim(line.substr(eq+1));
+            if ((val.size()>=2)&&(val.front()=='"')&&(val.back()=='"')) val=val.substr(1,val.size()-2);
+        }
+        if (prefix.empty()){
+            e=table.findExact(name);
+        } else {
+            key.assign(prefix);
+            key.append(name);
+            e=table.findExact(key);
+        }
+        if (!e.ptr) return(-1);
+        switch (e.argument){
+            case argument_none:
+                if (eq!=std::string_view::npos) return(-1);
                 break;
+            case argument_required:
+                if (eq==std::string_view::npos) return(-2);
+                break;
+            default:break;
+        }
+        if ((c=set(e.ptr,source_file,val))!=0) return(c);
+    }
+    return(0);
+}
+int parser::loadEnv(const lookup & table){
+    registry_t & r(*registry);
+    int c;
+    //Opcje innej tablicy (np. ict::options::compiled) nie są zarejestrowane w kontekście, więc zmiany setEnv() nie są zgłaszane
+    //i nazwy zmiennych są ustalane przy każdym wywołaniu.
+    if ((!r.envValid)||(&table!=&r.compiled)){
+        std::size_t n=table.optionCount();
+        r.envMap.clear();
+        r.envNames.clear();
+        for (std::size_t k=0;k<n;k++){
+            interface * ptr=table.optionAt(k);
+            if (!ptr->envName.empty()){
+                r.envNames.push_back(ptr->envName);
+            } else if ((!r.envPrefix.empty())&&(!ptr->longName.empty())){//Opcje bez długiej nazwy nie mają zmiennej z przedrostka.
+                std::string name(r.envPrefix);
+                for (const char & ch : ptr->longName) name+=std::isalnum((unsigned char)ch)?(char)std::toupper((unsigned char)ch):'_';
+                r.envNames.push_back(name);
+            } else {
+                r.envNames.emplace_back();
+            }
+        }
+        //Klucze wskazują na nazwy - tablica jest budowana po utworzeniu wszystkich nazw.
+        r.envMap.reserve(r.envNames.size());
+        for (std::size_t k=0;k<r.envNames.size();k++) if (!r.envNames[k].empty()){
+            if (!r.envMap.emplace(r.envNames[k],table.optionAt(k)).second){//Ta sama zmienna dla dwóch opcji.
+                r.envMap.clear();
+                r.envValid=false;
+                return(-1);
             }
         }
+        r.envValid=(&table==&r.compiled);
+    }
+    if (r.envMap.empty()) return(0);
+    for (char ** e=environ;*e;e++){
+        std::string_view entry(*e);
+        std::size_t eq=entry.find('=');
+        envMap_t::const_iterator it;
+        if (eq==std::string_view::npos) continue;
+        it=r.envMap.find(entry.substr(0,eq));
+        if (it!=r.envMap.cend()){
+            std::string_view val(entry.substr(eq+1));
+            if ((it->second->getKind()==kind_counter)&&val.empty()) continue;
+            if ((c=set(it->second,source_env,val))!=0) return(c);
+        }
     }
+    return(0);
+}
+//============================================
+interface::~interface(){
+    if (owner) owner->unregisterOpt(this);
+}
+interface & interface::setEnv(const std::string & name){
+    envName=name;
+    if (owner) owner->registry->envValid=false;
+    return(*this);
 }
 void interface::init(
+    parser * owner,
     const std::string & shortOpt,
     const std::string & longOpt,
     const std::string & defaultVal,
@@ -108,177 +835,484 @@ void interface::init(
     defaultValue=defaultVal;
     description=localeDesc;
     description.emplace_back(description_t{"",defaultDesc});
-    registerOpt(this);
+    if (owner){
+        owner->registerOpt(this);
+    } else {//Opcja bez kontekstu (np. ze schematu) - nazwami są pierwsze nazwy z list (np. dla zmiennych środowiskowych).
+        tokens_t tokens;
+        for (const char & c : shortOpt) if (std::isalnum(c)){
+            shortName=c;
+            break;
+        }
+        tokenizer(longOpt,tokens);
+        if (!tokens.empty()) longName=tokens.front();
+    }
 }
-
 //============================================
-typedef std::vector<struct option> longOptionsVector_t;
-int process(int argc,char * const argv[]){
-    int option_index=0;
-    std::string shortOptionsString(":");
-    longOptionsVector_t longOptionsVector;
+int parser::process(int argc,char * const argv[]){
+    registry_t & r(*registry);
+    phaseTimer_t timer(r.stats,&stats_t::process,"process");
+    counting_resource * counting=r.stats.enabled?dynamic_cast<counting_resource*>(resource):nullptr;
+    std::uint64_t allocations=counting?counting->getAllocations():0;
+    std::uint64_t bytes=counting?counting->getBytes():0;
+    int out;
+    finalize();
+    if (!r.compiled.valid){
+        phaseTimer_t t(r.stats,&stats_t::table,"table");
+        compile(r.shortOptionMap,r.longOptionMap,r.compiled);
+    }
     {
-        for (auto & ptr : getOptionMap()) ptr->clear();
-        getNotOption().clear();
-    }
-    for (shortOptionMap_t::const_iterator it=getShortOptionMap().cbegin();it!=getShortOptionMap().cend();++it){
-        shortOptionsString+=it->first;
-        if (it->second->getType()!=counter::type){//Parametr
-            shortOptionsString+=':';
-            if (!it->second->isValueRequired()){//Parametr nieobowiązkowy
-                shortOptionsString+=':';
-            }
-        }
+        phaseTimer_t t(r.stats,&stats_t::clear,"clear");
+        for (auto & ptr : r.optionMap) ptr->reset();
     }
-    for (longOptionMap_t::const_iterator it=getLongOptionMap().cbegin();it!=getLongOptionMap().cend();++it){
-        if (it->second->getType()==counter::type){//Brak parametru
-            longOptionsVector.emplace_back(option{it->first.c_str(),no_argument,NULL,0});
-        } else {
-            if (it->second->isValueRequired()){//Parametr obowiązkowy
-                longOptionsVector.emplace_back(option{it->first.c_str(),required_argument,NULL,0});
-            } else {//Parametr nieobowiązkowy
-                longOptionsVector.emplace_back(option{it->first.c_str(),optional_argument,NULL,0});
-            }
-        }
+    out=process(r.compiled,argc,argv);
+    if (!out){
+        phaseTimer_t t(r.stats,&stats_t::finish,"finish");
+        //finish() jest wywoływana dla wszystkich opcji (każda kończy swoją wartość) - zwracany jest pierwszy błąd.
+        for (auto & ptr : r.optionMap) if (r.stats.enabled?r.stats.finish(ptr):ptr->finish()) if (!out) out=-3;
+    }
+    if ((!out)&&r.endCallback) out=r.endCallback(nullptr,std::string_view());
+    if (counting){
+        r.stats.data.allocations+=counting->getAllocations()-allocations;
+        r.stats.data.allocatedBytes+=counting->getBytes()-bytes;
+    }
+    return(out);
+}
+int parser::process(const lookup & table,int argc,char * const argv[]){
+    int n;
+    int c;
+    std::string_view arg;
+    registry_t & r(*registry);
+    finalize();
+    auto notOption=[&r](const std::string_view & arg)->int{
+        phaseTimer_t timer(r.stats,&stats_t::notOptions);
+        if (r.store&store_view) r.notOptionView.push_back(arg);
+        if (r.store&store_copy) r.notOption.emplace_back(arg);
+        return(r.noOptionCallback?r.noOptionCallback(nullptr,arg):0);
+    };
+    auto option=[this](interface * ptr,const std::string_view & val)->int{
+        return(set(ptr,source_argv,val));
+    };
+    r.notOption.clear();
+    r.notOptionView.clear();
+    r.release();
+    if (!r.configFile.empty()){
+        phaseTimer_t timer(r.stats,&stats_t::config,"config");
+        if ((c=loadConfig(table))!=0) return(c);
     }
-    longOptionsVector.emplace_back(option{NULL,no_argument,NULL,0});
-    optind=1;
     {
-        int c;
-        while (1) {
-            int option_index=0;
-            c=getopt_long(argc,argv,shortOptionsString.c_str(),longOptionsVector.data(),&option_index);
-            if (c==-1) {
-                break;
-            } else if (std::isalnum(c)){//Zapisanie krótkiej opcji (jeśli jest)
-                if (getShortOptionMap().count(c)) 
-                    if (getShortOptionMap()[c]->setValue(optarg?optarg:"")!=0) 
-                        return(-3);
-            } else switch (c) {
-                case 0://Zapisanie długiej opcji
-                    if (getLongOptionMap().count(longOptionsVector.at(option_index).name)) 
-                        if (getLongOptionMap()[longOptionsVector.at(option_index).name]->setValue(optarg?optarg:"")!=0) 
-                            return(-3);
-                break;
-                case '?': //Short option character is not in optstring
-                    return(-1);
-                break;
-                case ':': //Missing mandatory parameter
-                    return(-2);
-                break;
-                default:
-                break;
+        phaseTimer_t timer(r.stats,&stats_t::env,"env");
+        if ((c=loadEnv(table))!=0) return(c);
+    }
+    phaseTimer_t timer(r.stats,&stats_t::parse,"parse");
+    arguments_t args(argc,argv,r.responseFiles,r.mappings);
+    while ((n=args.next(arg))>0){
+        if ((arg.size()<2)||(arg[0]!='-')){//Argument, który nie jest opcją.
+            if ((c=notOption(arg))!=0) return(c);
+        } else if (arg[1]!='-'){//Krótkie opcje (również kilka w jednym argumencie).
+            for (std::size_t i=1;i<arg.size();i++){
+                entry_t e(table.findShort(arg[i]));
+                std::string_view val;
+                if (!e.ptr) return(-1);
+                if (e.argument!=argument_none){
+                    if (i+1<arg.size()){
+                        val=arg.substr(i+1);
+                    } else if (e.argument==argument_required){
+                        if ((n=args.next(val))<=0) return(n?n:-2);
+                    }
+                    i=arg.size();
+                }
+                if ((c=option(e.ptr,val))!=0) return(c);
             }
-        }
-        while (optind<argc){
-            getNotOption().push_back(argv[optind++]);
+        } else if (arg.size()==2){//Koniec opcji ("--").
+            while ((n=args.next(arg))>0) if ((c=notOption(arg))!=0) return(c);
+            if (n) return(n);
+        } else {//Długa opcja.
+            std::string_view name(arg.substr(2));
+            std::string_view val;
+            std::size_t eq=name.find('=');
+            entry_t e;
+            if (eq!=std::string_view::npos){
+                val=name.substr(eq+1);
+                name=name.substr(0,eq);
+            }
+            e=table.findLong(name);
+            if (!e.ptr) return(-1);
+            switch (e.argument){
+                case argument_none:
+                    if (eq!=std::string_view::npos) return(-1);
+                    break;
+                case argument_required:
+                    if (eq==std::string_view::npos){
+                        if ((n=args.next(val))<=0) return(n?n:-2);
+                    }
+                    break;
+                default:break;
+            }
+            if ((c=option(e.ptr,val))!=0) return(c);
         }
     }
-    return(0);
+    return(n);
 }
-void help(interface * ptr,std::ostream & os,const std::string & locale){
+//! 
+//! @brief Dopisuje tekst pomocy dla danej opcji.
+//! 
+//! @param shortName Krótka nazwa opcji (0 - brak).
+//! @param longName Długa nazwa opcji (pusta - brak).
+//! @param ptr Wskaźnik do obiektu obsługującego opcję.
+//! @param out Bufor z tekstem pomocy.
+//! @param locale Wskazanie lokalizacji (język itp.) 
+//! @param catalog Opisy z katalogu dla tej lokalizacji.
+//! 
+static void helpOption(char shortName,const std::string & longName,interface * ptr,std::string & out,const locale_id & locale,const catalog_t & catalog){
     bool present=false;
     bool first=true;
-    for (shortOptionMap_t::const_iterator it=getShortOptionMap().cbegin();it!=getShortOptionMap().cend();++it) if (it->second==ptr){
-        if (first){
-            first=false;
-        } else {
-            os<<',';
-        }
-        os<<'-'<<it->first;
+    if (shortName){
+        out+='-';
+        out+=shortName;
     }
-    for (longOptionMap_t::const_iterator it=getLongOptionMap().cbegin();it!=getLongOptionMap().cend();++it) if (it->second==ptr) {
-        if (first){
-            first=false;
-        } else {
-            os<<',';
-        }
-        os<<"--"<<it->first;
+    if (!longName.empty()){
+        if (shortName) out+=',';
+        out+="--";
+        out+=longName;
     }
-    os<<' ';
-    if (ptr->getType()!=counter::type){
+    out+=' ';
+    if (ptr->getKind()!=kind_counter){
         if (ptr->isValueRequired()){//Parametr obowiązkowy
-            os<<"<mandatory param>";
+            out+="<mandatory param>";
         } else {//Parametr nieobowiązkowy
-            os<<"<optional param>";
+            out+="<optional param>";
         }
-        os<<' ';
+        out+=' ';
     }
-    first=true;
-    for (const description_t & d : ptr->getDescription()) {
+    if (!catalog.empty()){
+        catalog_t::const_iterator it=catalog.find(longName);
+        if (it!=catalog.cend()){
+            present=true;
+            first=false;
+            out+=it->second;
+        }
+    }
+    if (!present) for (const description_t & d : ptr->getDescription()) {
         if (locale==d.locale){
             present=true;
             if (first){
                 first=false;
             } else {
-                os<<' ';
+                out+=' ';
             }
-            os<<d.desc;
+            out+=d.desc;
         }
     }
     if (!present) for (const description_t & d : ptr->getDescription()) {
         if (d.locale.empty()){
-            present=true;
             if (first){
                 first=false;
             } else {
-                os<<' ';
+                out+=' ';
             }
-            os<<d.desc;
+            out+=d.desc;
         }
     }
-    first=true;
     if (!ptr->getDefaultValue().empty()){
-        os<<" Default: ";
-        if (ptr->getType()==vector<int>::type){
-            std::string val;
-            std::istringstream s(ptr->getDefaultValue());
-            while (std::getline(s,val,'\n')){
+        const std::string & def(ptr->getDefaultValue());
+        out+=" Default: ";
+        if (ptr->getKind()==kind_vector){
+            std::size_t pos=0;
+            first=true;
+            while (pos<def.size()){//Wartości rozdzielone znakiem nowej linii (jak w std::getline()).
+                std::size_t end=def.find('\n',pos);
+                if (end==std::string::npos) end=def.size();
                 if (first){
                     first=false;
                 } else {
-                    os<<',';
-                };
-                os<<"\""<<val<<"\"";
+                    out+=',';
+                }
+                out+='"';
+                out.append(def,pos,end-pos);
+                out+='"';
+                pos=end+1;
             }
         } else {
-            os<<"\""<<ptr->getDefaultValue()<<"\"";
+            out+='"';
+            out+=def;
+            out+='"';
         }
-        os<<".";
+        out+='.';
     }
-    os<<std::endl;
+    out+='\n';
 }
-void help(std::ostream & os,const std::string & locale){
-    optionSet_t optionSet;
-    for (shortOptionMap_t::const_iterator it=getShortOptionMap().cbegin();it!=getShortOptionMap().cend();++it){
-        if (!optionSet.count(it->second)){
-            optionSet.insert(it->second);
-            help(it->second,os,locale);
+const std::string & parser::helpText(const std::string & locale){
+    finalize();
+    return(static_cast<const parser &>(*this).helpText(locale));
+}
+const std::string & parser::helpText(const std::string & locale) const {
+    std::lock_guard<std::mutex> lock(registry->helpMutex);
+    helpCache_t::const_iterator it=registry->helpCache.find(locale);
+    if (it==registry->helpCache.cend()){
+        phaseTimer_t timer(registry->stats,&stats_t::help,"help");
+        const shortOptionMap_t & shortOptionMap(registry->shortOptionMap);
+        const longOptionMap_t & longOptionMap(registry->longOptionMap);
+        const std::string * key=&locale;
+        locale_id id;
+        std::string out;
+        std::size_t size=0;
+        catalog_t catalog;
+        mappings_t mappings;
+        auto load=[this,&catalog,&mappings](const std::string & l)->bool{
+            char * begin;
+            char * end;
+            if (registry->catalog.empty()) return(false);
+            if (mapFile(registry->catalog,false,mappings,begin,end)) return(false);
+            return(loadCatalog(begin,end,l,catalog));
+        };
+        //Nieznana lokalizacja (bez opisów w opcjach i w katalogu) nie jest dodawana do tablicy lokalizacji 
+        //ani zapamiętywana pod własną nazwą - używany jest tekst dla domyślnej lokalizacji.
+        bool section=load(locale);
+        if ((!locale_id::find(locale,id))&&(!section)){
+            static const std::string defaultLocale;
+            for (const mapping_t & m : mappings) munmap(m.addr,m.size);
+            mappings.clear();
+            catalog.clear();
+            key=&defaultLocale;
+            it=registry->helpCache.find(defaultLocale);
+            if (it!=registry->helpCache.cend()) return(it->second);
+            id=locale_id();
+            load(defaultLocale);
         }
-    }
-    for (longOptionMap_t::const_iterator it=getLongOptionMap().cbegin();it!=getLongOptionMap().cend();++it){
-        if (!optionSet.count(it->second)){
-            optionSet.insert(it->second);
-            help(it->second,os,locale);
+        for (interface * ptr : registry->optionMap){//Szacowany rozmiar tekstu.
+            size+=ptr->longName.size()+ptr->getDefaultValue().size()+48;
+            for (const description_t & d : ptr->getDescription()) size+=d.desc.size()+1;
+        }
+        out.reserve(size);
+        //Najpierw opcje z krótką nazwą (według krótkich nazw), potem pozostałe (według długich nazw).
+        for (shortOptionMap_t::const_iterator i=shortOptionMap.cbegin();i!=shortOptionMap.cend();++i){
+            helpOption(i->first,i->second->longName,i->second,out,id,catalog);
         }
+        for (longOptionMap_t::const_iterator i=longOptionMap.cbegin();i!=longOptionMap.cend();++i){
+            if (!i->second->shortName) helpOption(0,i->first,i->second,out,id,catalog);
+        }
+        for (const mapping_t & m : mappings) munmap(m.addr,m.size);
+        it=registry->helpCache.emplace(*key,std::move(out)).first;
+    }
+    return(it->second);
+}
+void parser::help(std::ostream & os,const std::string & locale){
+    const std::string & text(helpText(locale));
+    os.write(text.data(),text.size());
+}
+void parser::help(std::ostream & os,const std::string & locale) const {
+    const std::string & text(helpText(locale));
+    os.write(text.data(),text.size());
+}
+const notOption_t & parser::noOptions() const {
+    return(registry->notOption);
+}
+const notOptionView_t & parser::noOptionsView() const {
+    return(registry->notOptionView);
+}
+void parser::setNoOptionsStore(store_t store){
+    registry->store=store;
+}
+store_t parser::getNoOptionsStore() const {
+    return(registry->store);
+}
+void parser::setResponseFiles(bool enable){
+    registry->responseFiles=enable;
+}
+bool parser::getResponseFiles() const {
+    return(registry->responseFiles);
+}
+void parser::setConfigFile(const std::string & path){
+    registry->configFile=path;
+}
+const std::string & parser::getConfigFile() const {
+    return(registry->configFile);
+}
+void parser::setCatalog(const std::string & path){
+    registry->catalog=path;
+    registry->helpCache.clear();
+}
+const std::string & parser::getCatalog() const {
+    return(registry->catalog);
+}
+void parser::setEnvPrefix(const std::string & prefix){
+    registry->envPrefix=prefix;
+    registry->envValid=false;
+}
+const std::string & parser::getEnvPrefix() const {
+    return(registry->envPrefix);
+}
+void parser::setStats(bool enable,bool trace){
+    statsState_t & st(registry->stats);
+    if (enable&&!st.enabled) st.origin=std::chrono::steady_clock::now();
+    st.enabled=enable;
+    st.trace=enable&&trace;
+}
+bool parser::getStats() const {
+    return(registry->stats.enabled);
+}
+const stats_t & parser::stats() const {
+    return(registry->stats.data);
+}
+void parser::resetStats(){
+    statsState_t & st(registry->stats);
+    st.data=stats_t();
+    st.types.clear();
+    st.events.clear();
+    st.origin=std::chrono::steady_clock::now();
+}
+void parser::traceDump(std::ostream & os) const {
+    const statsState_t & st(registry->stats);
+    std::string out;
+    char buffer[160];
+    int pid=(int)getpid();
+    out.reserve(64+st.events.size()*96);
+    out+="{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (std::size_t k=0;k<st.events.size();k++){
+        const traceEvent_t & e(st.events[k]);
+        int n=std::snprintf(buffer,sizeof(buffer),"%s{\"name\":\"%s\",\"cat\":\"options\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":0}",
+            k?",":"",e.name,e.start/1000.0,e.duration/1000.0,pid);
+        if (n>0) out.append(buffer,std::min<std::size_t>(n,sizeof(buffer)-1));
     }
+    out+="]}\n";
+    os.write(out.data(),out.size());
+}
+void parser::setNoOptionCallback(const callback_t & callback){
+    registry->noOptionCallback=callback;
+}
+void parser::setOptionCallback(const callback_t & callback){
+    registry->optionCallback=callback;
+}
+void parser::setEndCallback(const callback_t & callback){
+    registry->endCallback=callback;
+}
+const callback_t & parser::getEndCallback() const {
+    return(registry->endCallback);
+}
+//============================================
+int process(int argc,char * const argv[]){
+    return(defaultParser().process(argc,argv));
+}
+void help(std::ostream & os,const std::string & locale){
+    defaultParser().help(os,locale);
 }
 const notOption_t & noOptions(){
-    return(getNotOption());
+    return(defaultParser().noOptions());
+}
+const notOptionView_t & noOptionsView(){
+    return(defaultParser().noOptionsView());
+}
+const stats_t & stats(){
+    return(defaultParser().stats());
+}
+//============================================
+//! Pula wątków używana przez runParallel().
+class pool_t {
+private:
+    //! Wątki puli.
+    std::vector<std::thread> threads;
+    //! Chroni stan puli (poniższe pola).
+    std::mutex mutex;
+    //! Budzi wątki puli (nowe zadania lub zakończenie).
+    std::condition_variable wake;
+    //! Informuje wątek wywołujący o zakończeniu pracy wątków puli.
+    std::condition_variable done;
+    //! Pozwala na wykonywanie zadań tylko jednego wywołania runParallel() naraz.
+    std::mutex busy;
+    //! Zadanie.
+    void (*task)(void *,std::size_t)=nullptr;
+    //! Kontekst przekazywany do zadania.
+    void * context=nullptr;
+    //! Liczba zadań.
+    std::size_t count=0;
+    //! Indeks kolejnego zadania do wykonania.
+    std::atomic<std::size_t> next{0};
+    //! Liczba wątków puli, które mogą jeszcze dołączyć do wykonywania zadań.
+    unsigned int slots=0;
+    //! Liczba wątków puli wykonujących zadania.
+    unsigned int working=0;
+    //! Informacja, czy wątki puli mają się zakończyć.
+    bool stop=false;
+    //! Wykonuje zadania, dopóki są jakieś do wykonania.
+    void work(void (*t)(void *,std::size_t),void * c,std::size_t n){
+        for (std::size_t i=next.fetch_add(1);i<n;i=next.fetch_add(1)) t(c,i);
+    }
+    //! Pętla wątku puli.
+    void loop(){
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;){
+            wake.wait(lock,[this]{return(stop||slots);});
+            if (stop) return;
+            slots--;
+            working++;
+            {
+                void (*t)(void *,std::size_t)=task;
+                void * c=context;
+                std::size_t n=count;
+                lock.unlock();
+                work(t,c,n);
+                lock.lock();
+            }
+            if (!(--working)) done.notify_all();
+        }
+    }
+public:
+    ~pool_t(){
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop=true;
+        }
+        wake.notify_all();
+        for (std::thread & t : threads) t.join();
+    }
+    //! Patrz ict::options::runParallel()
+    void run(std::size_t n,unsigned int limit,void (*t)(void *,std::size_t),void * c){
+        std::unique_lock<std::mutex> job(busy,std::try_to_lock);
+        unsigned int helpers=0;
+        if (job.owns_lock()&&(limit>1)&&(n>1)){
+            helpers=std::min<std::size_t>(limit,n)-1;
+            try{
+                while (threads.size()<helpers) threads.emplace_back(&pool_t::loop,this);
+            } catch (const std::system_error &){//Zadania wykonują wątki, które udało się utworzyć.
+            }
+            if (helpers>threads.size()) helpers=threads.size();
+        }
+        if (!helpers){//Bez puli - wszystkie zadania w wątku wywołującym.
+            for (std::size_t i=0;i<n;i++) t(c,i);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task=t;
+            context=c;
+            count=n;
+            next=0;
+            slots=helpers;
+        }
+        wake.notify_all();
+        work(t,c,n);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            slots=0;//Wątki, które jeszcze nie dołączyły, nie mają już czego wykonywać.
+            done.wait(lock,[this]{return(!working);});
+        }
+    }
+};
+void runParallel(std::size_t count,unsigned int threads,void (*task)(void * context,std::size_t index),void * context){
+    static pool_t pool;
+    pool.run(count,threads,task,context);
 }
 //===========================================
 } }
 //===========================================
 #ifdef ENABLE_TESTING
 #include "test.hpp"
+#include "testing.hpp"
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <list>
 
-static int testProcess(const std::vector<std::string> & input){
-    std::vector<std::string> a(input);
-    std::vector<char*> v;
-    for (auto & s : a) v.push_back(&s[0]);
-    v.push_back(nullptr);
-    return(ict::options::process(a.size(),&v[0]));
-}
 ict::options::counter param1("cfj","ala ma kota","5","Opis param1 (licznik domyślnie ustawiony na 5).");
 ict::options::counter param2("ush","brak kotow","","Opis param2 (licznik bez domyślnej wartości).");
 ict::options::single<int> param3("cbe","calkiem inny parametr","-50","Opis param3 (int domyślnie ustawiony na -50).");
@@ -636,5 +1670,717 @@ REGISTER_TEST(options,tc18){
     if (!out) if (ict::options::noOptions().size()!=0) out=118;
     return(out);
 }
+REGISTER_TEST(options,tc19){
+    int out=0;
+    out=testProcess({"test","-c"});
+    if (!out) if (param1.value!=1) out=101;
+    if (!out) {
+        static ict::options::counter param10("","pozna opcja","","Opis param10 (licznik zarejestrowany po pierwszym wywołaniu process()).");
+        out=testProcess({"test","--pozna","--pozna","-c"});
+        if (!out) if (param10.value!=2) out=102;
+        if (!out) if (param1.value!=1) out=103;
+    }
+    return(out);
+}
+REGISTER_TEST(options,tc20){
+    int out=0;
+    out=testProcess({"test","--calk=12","--br","--brak"});
+    if (!out) if (param1.value!=5) out=101;
+    if (!out) if (param2.value!=2) out=102;
+    if (!out) if (param3.counter!=1) out=103;
+    if (!out) if (param3.value!=12) out=104;
+    if (!out) if (ict::options::noOptions().size()!=0) out=118;
+    return(out);
+}
+REGISTER_TEST(options,tc21){
+    int out=0;
+    if (testProcess({"test","--in","5"})!=-1) out=101;
+    if (!out) if (testProcess({"test","--ala=5"})!=-1) out=102;
+    if (!out) if (testProcess({"test","-c","-x"})!=-1) out=103;
+    if (!out) if (testProcess({"test","-c","-b"})!=-2) out=104;
+    return(out);
+}
+REGISTER_TEST(options,tc22){
+    int out=0;
+    out=testProcess({"test","plik1","-c","plik2","--","-c","--ala"});
+    if (!out) if (param1.value!=1) out=101;
+    if (!out) if (ict::options::noOptions().size()!=4) out=118;
+    if (!out) if (ict::options::noOptions().at(0)!="plik1") out=120;
+    if (!out) if (ict::options::noOptions().at(1)!="plik2") out=121;
+    if (!out) if (ict::options::noOptions().at(2)!="-c") out=122;
+    if (!out) if (ict::options::noOptions().at(3)!="--ala") out=123;
+    return(out);
+}
+REGISTER_TEST(options,tc23){
+    int out=0;
+    out=testProcess({"test","-b899","-cci","1.5","-"});
+    if (!out) if (param1.value!=2) out=101;
+    if (!out) if (param3.counter!=1) out=103;
+    if (!out) if (param3.value!=899) out=104;
+    if (!out) if (param5.counter!=1) out=107;
+    if (!out) if (param5.value.size()!=1) out=108;
+    if (!out) if (param5.value.at(0)!=1.5) out=109;
+    if (!out) if (ict::options::noOptions().size()!=1) out=118;
+    if (!out) if (ict::options::noOptions().at(0)!="-") out=120;
+    return(out);
+}
+REGISTER_TEST(options,tc24){
+    std::atomic<int> out(0);
+    std::vector<std::thread> threads;
+    for (int t=0;t<8;t++) threads.emplace_back([t,&out](){
+        ict::options::parser p;
+        ict::options::counter verbose(p,"v","verbose","","Opis verbose.");
+        ict::options::single<int> port(p,"p","port","80","Opis port.");
+        ict::options::vector<std::string> files(p,"f","file","","Opis file.");
+        for (int k=0;(k<1000)&&(!out);k++){
+            std::vector<std::string> a({"test","-vv","--port",std::to_string(t*1000+k),"-f","a","--file=b","plik"});
+            if (testProcess(p,a)) out=101;
+            if (!out) if (verbose.value!=2) out=102;
+            if (!out) if (port.value!=(t*1000+k)) out=103;
+            if (!out) if (files.value.size()!=2) out=104;
+            if (!out) if (files.value.at(1)!="b") out=105;
+            if (!out) if (p.noOptions().size()!=1) out=106;
+            if (!out) if (p.noOptions().at(0)!="plik") out=107;
+        }
+    });
+    for (auto & t : threads) t.join();
+    if (!out) if (testProcess({"test","-c"})) out=108;
+    if (!out) if (param1.value!=1) out=109;
+    if (!out) if (testProcess({"test","--port","1"})!=-1) out=110;
+    return(out);
+}
+REGISTER_TEST(options,tc25){
+    int out=0;
+    {
+        ict::options::counter param11("","tymczasowa","","Opis param11 (licznik istniejący tylko w tym zakresie).");
+        out=testProcess({"test","--tymczasowa"});
+        if (!out) if (param11.value!=1) out=101;
+    }
+    if (!out) if (testProcess({"test","--tymczasowa"})!=-1) out=102;
+    return(out);
+}
+REGISTER_TEST(options,tc26){
+    int out=0;
+    if (testProcess({"test","-b","12abc"})!=-3) out=101;
+    if (!out) if (testProcess({"test","-b","99999999999"})!=-3) out=102;
+    if (!out) if (testProcess({"test","-b"," 12"})!=-3) out=103;
+    if (!out) if (testProcess({"test","-i","1e3x"})!=-3) out=104;
+    if (!out) if (testProcess({"test","-b","+-1"})!=-3) out=105;
+    if (!out) out=testProcess({"test","-b","+7","-i","2.5e2","-i","-0.125"});
+    if (!out) if (param3.value!=7) out=106;
+    if (!out) if (param5.value.size()!=2) out=107;
+    if (!out) if (param5.value.at(0)!=250) out=108;
+    if (!out) if (param5.value.at(1)!=-0.125) out=109;
+    return(out);
+}
+REGISTER_TEST(options,tc27){
+    int out=0;
+    ict::options::parser p;
+    ict::options::single<std::string_view> name(p,"n","name","domyslna","Opis name.");
+    ict::options::vector<std::string_view> files(p,"f","file","a\nb","Opis file.");
+    std::vector<std::string> a({"test","-n","ala","--file=x","-fy","plik"});
+    if (testProcess(p,{"test"})) out=101;
+    if (!out) if (name.value!="domyslna") out=102;
+    if (!out) if (name.value.data()!=name.getDefaultValue().data()) out=103;
+    if (!out) if (files.value.size()!=2) out=104;
+    if (!out) if ((files.value.at(0)!="a")||(files.value.at(1)!="b")) out=105;
+    if (!out) if (testProcess(p,a)) out=106;
+    if (!out) if (name.value.data()!=a[2].data()) out=107;
+    if (!out) if (files.value.size()!=2) out=108;
+    if (!out) if (files.value.at(0).data()!=a[3].data()+7) out=109;
+    if (!out) if (files.value.at(1).data()!=a[4].data()+2) out=110;
+    if (!out) if (p.noOptionsView().size()!=1) out=111;
+    if (!out) if (p.noOptionsView().at(0).data()!=a[5].data()) out=112;
+    if (!out) if (p.noOptions().size()!=1) out=113;
+    p.setNoOptionsStore(ict::options::store_view);
+    if (!out) if (testProcess(p,a)) out=114;
+    if (!out) if (p.noOptions().size()!=0) out=115;
+    if (!out) if (p.noOptionsView().size()!=1) out=116;
+    p.setNoOptionsStore(ict::options::store_none);
+    if (!out) if (testProcess(p,a)) out=117;
+    if (!out) if (p.noOptionsView().size()!=0) out=118;
+    return(out);
+}
+//! Zasób pamięci zliczający alokacje.
+class testResource : public std::pmr::memory_resource {
+public:
+    std::size_t count=0;
+private:
+    void * do_allocate(std::size_t bytes,std::size_t alignment){
+        count++;
+        return(std::pmr::new_delete_resource()->allocate(bytes,alignment));
+    }
+    void do_deallocate(void * ptr,std::size_t bytes,std::size_t alignment){
+        std::pmr::new_delete_resource()->deallocate(ptr,bytes,alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept {
+        return(this==&other);
+    }
+};
+REGISTER_TEST(options,tc28){
+    int out=0;
+    testResource resource;
+    {
+        ict::options::parser p(&resource);
+        ict::options::pmr::vector<int> numbers(p,"n","number","1\n2","Opis number.");
+        ict::options::pmr::vector<std::pmr::string> names(p,"s","name","","Opis name.");
+        std::vector<std::string> a({"test","-n","3","--name=bardzo-dluga-nazwa-bez-optymalizacji-sso","-n4","plik"});
+        if (testProcess(p,{"test"})) out=101;
+        if (!out) if ((numbers.value.size()!=2)||(numbers.value.at(1)!=2)) out=102;
+        if (!out) if (testProcess(p,a)) out=103;
+        if (!out) if ((numbers.value.size()!=2)||(numbers.value.at(0)!=3)||(numbers.value.at(1)!=4)) out=104;
+        if (!out) if (numbers.value.get_allocator().resource()!=&resource) out=105;
+        if (!out) if (names.value.size()!=1) out=106;
+        if (!out) if (names.value.at(0)!="bardzo-dluga-nazwa-bez-optymalizacji-sso") out=107;
+        if (!out) if (names.value.at(0).get_allocator().resource()!=&resource) out=108;
+        if (!out) if (p.noOptionsView().get_allocator().resource()!=&resource) out=109;
+        if (!out) if (p.getMemoryResource()!=&resource) out=110;
+        a.at(4)="-nx";
+        if (!out) if (testProcess(p,a)!=-3) out=111;
+        if (!out) if ((numbers.value.size()!=1)||(numbers.value.at(0)!=3)) out=112;
+    }
+    if (!out) if (resource.count==0) out=113;
+    if (!out) if (ict::options::defaultParser().getMemoryResource()!=std::pmr::get_default_resource()) out=114;
+    return(out);
+}
+REGISTER_TEST(options,tc29){
+    int out=0;
+    ict::options::parser p;
+    ict::options::lazy<ict::options::single<int>> port(p,"p","port","80","Opis port.");
+    ict::options::lazy<ict::options::vector<double>> values(p,"x","value","1.5\n2.5","Opis value.");
+    std::vector<std::string> a({"test","-p","8080","-x","0.25","--value=abc","--value","4"});
+    if (testProcess(p,{"test"})) out=101;
+    if (!out) if (port.get()!=80) out=102;
+    if (!out) if ((values.get().size()!=2)||(values.get().at(1)!=2.5)) out=103;
+    if (!out) if (testProcess(p,a)) out=104;//Niepoprawna wartość nie jest wykrywana podczas parsowania.
+    if (!out) if (port.counter!=1) out=105;
+    if (!out) if (port.getRaw().data()!=a[2].data()) out=106;
+    if (!out) if (port.get()!=8080) out=107;
+    if (!out) if (&port.get()!=&port.get()) out=108;
+    if (!out) if (values.counter!=3) out=109;
+    if (!out) if (values.getRaw().size()!=3) out=110;
+    if (!out) {
+        try{
+            values.get();
+            out=111;
+        } catch (const std::invalid_argument &){
+        }
+    }
+    a.at(5)="--value=3";
+    if (!out) if (testProcess(p,a)) out=112;
+    if (!out) if ((values.get().size()!=3)||(values.get().at(0)!=0.25)||(values.get().at(1)!=3)||(values.get().at(2)!=4)) out=113;
+    {//Kontener bez reserve() oraz kontener korzystający z zasobu pamięci kontekstu parsera.
+        ict::options::counting_resource resource;
+        ict::options::parser q(&resource);
+        ict::options::lazy<ict::options::vector<int,std::list<int>>> items(q,"i","item","","Opis item.");
+        ict::options::lazy<ict::options::pmr::vector<int>> numbers(q,"n","number","","Opis number.");
+        if (!out) if (testProcess(q,{"test","-i1","-i2","-n3","-n4"})) out=114;
+        if (!out) if ((items.get().size()!=2)||(items.get().back()!=2)) out=115;
+        if (!out) if ((numbers.get().size()!=2)||(numbers.get().back()!=4)) out=116;
+        if (!out) if (numbers.get().get_allocator().resource()!=&resource) out=117;
+    }
+    return(out);
+}
+//! Typ zliczający konwersje wartości.
+struct testCounted {
+    static int conversions;
+    int v=0;
+    void clear(){v=0;}
+    friend std::istream & operator>>(std::istream & input,testCounted & c){
+        conversions++;
+        return(input>>c.v);
+    }
+};
+int testCounted::conversions=0;
+//! Typ, którego konwersja (parse()) zgłasza wyjątek dla wartości "!".
+struct testThrowing {
+    int v=0;
+    int parse(const std::string_view & val){
+        if (val=="!") throw std::runtime_error("testThrowing");
+        return(ict::options::convert(val,v));
+    }
+};
+REGISTER_TEST(options,tc30){
+    int out=0;
+    ict::options::parser p;
+    ict::options::counter level(p,"l","level","2","Opis level.");
+    ict::options::single<testCounted> one(p,"o","one","5","Opis one.");
+    ict::options::vector<testCounted> many(p,"m","many","1\n2\n3","Opis many.");
+    std::vector<std::string> a({"test","-o","7","-m","8","-lll"});
+    testCounted::conversions=0;
+    for (int k=0;(k<3)&&(!out);k++){
+        if (testProcess(p,{"test"})) out=101;
+        if (!out) if (level.value!=2) out=102;
+        if (!out) if (one.value.v!=5) out=103;
+        if (!out) if ((many.value.size()!=3)||(many.value.at(2).v!=3)) out=104;
+        if (!out) if (testCounted::conversions!=4) out=105;//Wartości domyślne konwertowane tylko raz.
+        one.value.v=0;
+        many.value.clear();
+    }
+    if (!out) if (testProcess(p,a)) out=106;
+    if (!out) if (level.value!=3) out=107;
+    if (!out) if (one.value.v!=7) out=108;
+    if (!out) if ((many.value.size()!=1)||(many.value.at(0).v!=8)) out=109;
+    if (!out) if (testCounted::conversions!=6) out=110;
+    if (!out) if (testProcess(p,{"test"})) out=111;
+    if (!out) if ((level.value!=2)||(one.value.v!=5)||(many.value.size()!=3)) out=112;
+    return(out);
+}
+//! 
+//! @brief Tworzy plik tymczasowy o danej zawartości.
+//! 
+//! @param content Zawartość.
+//! @return Ścieżka do pliku (pusta - błąd).
+//! 
+static std::string testFile(const std::string & content){
+    char path[]="/tmp/ict-options-XXXXXX";
+    int fd=mkstemp(path);
+    if (fd<0) return("");
+    if (write(fd,content.data(),content.size())!=(ssize_t)content.size()) path[0]=0;
+    close(fd);
+    return(path);
+}
+REGISTER_TEST(options,tc31){
+    int out=0;
+    ict::options::parser p;
+    ict::options::counter verbose(p,"v","verbose","","Opis verbose.");
+    ict::options::single<int> port(p,"p","port","80","Opis port.");
+    ict::options::vector<std::string_view> files(p,"f","file","","Opis file.");
+    std::string nested(testFile("plik3 --port\n\n  8080 -v"));
+    std::string main(testFile("-v 'plik z spacja' \"cudzy\\\"slow\" -f a\\ b @"+nested+"\n--file=x'y'z"));
+    std::string loop(testFile("-v @"));
+    std::string empty(testFile(""));
+    std::vector<std::string> a({"test","plik1","@"+main,"@"+empty,"-f","c","--","-v","@"+nested});
+    if (nested.empty()||main.empty()||loop.empty()||empty.empty()) out=101;
+    if (!out) if (testProcess(p,a)) out=102;
+    if (!out) if (p.noOptions().size()!=5) out=103;//Bez obsługi plików odpowiedzi.
+    p.setResponseFiles(true);
+    if (!out) if (testProcess(p,a)) out=104;
+    if (!out) if (verbose.value!=2) out=105;
+    if (!out) if (port.value!=8080) out=106;
+    if (!out) if (files.value.size()!=3) out=107;
+    if (!out) if ((files.value.at(0)!="a b")||(files.value.at(1)!="xyz")||(files.value.at(2)!="c")) out=108;
+    if (!out) if (p.noOptions().size()!=9) out=109;
+    if (!out) if (p.noOptions().at(0)!="plik1") out=110;
+    if (!out) if (p.noOptions().at(1)!="plik z spacja") out=111;
+    if (!out) if (p.noOptions().at(2)!="cudzy\"slow") out=112;
+    if (!out) if (p.noOptions().at(3)!="plik3") out=113;
+    if (!out) if ((p.noOptions().at(4)!="-v")||(p.noOptions().at(5)!="plik3")||(p.noOptions().at(8)!="-v")) out=114;
+    a.at(3)="@/nie/istniejacy/plik";
+    if (!out) if (testProcess(p,a)!=-4) out=115;
+    {
+        std::ofstream f(loop,std::ios::app);
+        f<<loop;
+    }
+    a.at(3)="@"+loop;
+    if (!out) if (testProcess(p,a)!=-4) out=116;
+    for (const std::string & f : {nested,main,loop,empty}) if (!f.empty()) unlink(f.c_str());
+    return(out);
+}
+REGISTER_TEST(options,tc32){
+    int out=0;
+    ict::options::parser p;
+    ict::options::counter verbose(p,"v","verbose","","Opis verbose.");
+    ict::options::single<int> port(p,"p","port","80","Opis port.");
+    std::vector<std::string> a({"test","plik1","-v","--port=8080","plik2","--","-v","stop","plik3"});
+    std::string events;
+    auto f=[&events,&port](ict::options::interface * option,const std::string_view & value)->int{
+        if (option) {
+            events+=option->getShortOption();
+            if ((option==&port)&&(port.value!=8080)) return(101);//Wartość jest już zapisana.
+        } else {
+            events+='[';
+            events+=value;
+            events+=']';
+            if (value=="stop") return(1);
+        }
+        return(0);
+    };
+    p.setNoOptionsStore(ict::options::store_none);
+    p.setNoOptionCallback(ict::options::callback_t::wrap(f));
+    if (testProcess(p,a)!=1) out=102;
+    if (!out) if (events!="[plik1][plik2][-v][stop]") out=103;
+    if (!out) if (p.noOptions().size()||p.noOptionsView().size()) out=104;
+    p.setOptionCallback(ict::options::callback_t::wrap(f));
+    events.clear();
+    if (!out) if (testProcess(p,a)!=1) out=105;
+    if (!out) if (events!="[plik1]vp[plik2][-v][stop]") out=106;
+    p.setNoOptionCallback(ict::options::callback_t());
+    p.setOptionCallback(ict::options::callback_t());
+    events.clear();
+    if (!out) if (testProcess(p,a)) out=107;
+    if (!out) if (!events.empty()) out=108;
+    return(out);
+}
+REGISTER_TEST(options,tc33){
+    int out=0;
+    ict::options::parser p;
+    ict::options::vector<int> numbers(p,"n","number","1\n2","Opis number.");
+    ict::options::vector<double> values(p,"x","value","","Opis value.");
+    std::vector<std::string> a({"test"});
+    numbers.bulk(1000,4);
+    values.bulk(1,3);
+    for (int k=0;k<10000;k++){
+        a.push_back("-n"+std::to_string(k));
+        if (k<10) a.push_back("-x"+std::to_string(k)+".5");
+    }
+    if (testProcess(p,{"test"})) out=101;
+    if (!out) if (numbers.value.size()!=2) out=102;
+    if (!out) if (testProcess(p,a)) out=103;
+    if (!out) if (numbers.value.size()!=10000) out=104;
+    if (!out) for (int k=0;k<10000;k++) if (numbers.value.at(k)!=k){
+        out=105;
+        break;
+    }
+    if (!out) if ((values.value.size()!=10)||(values.value.at(9)!=9.5)) out=106;
+    a.at(7001)="-nx";
+    a.at(5001)="-n5x";
+    if (!out) if (testProcess(p,a)!=-3) out=107;
+    if (!out) if (numbers.value.size()!=4990) out=108;//Wartości przed pierwszą niepoprawną wartością.
+    numbers.bulk(20000);
+    if (!out) if (testProcess(p,a)!=-3) out=109;
+    if (!out) if (numbers.value.size()!=4990) out=110;
+    numbers.bulk(0);
+    if (!out) if (testProcess(p,a)!=-3) out=111;
+    if (!out) if (numbers.value.size()!=4990) out=112;
+    {
+        ict::options::parser q;
+        ict::options::vector<testThrowing> items(q,"i","item","","Opis item.");
+        std::vector<std::string> c({"test","-i1","-i2","-i!","-i4"});
+        items.bulk(1,2);//Wyjątek w wątku jest zgłaszany jako błąd konwersji.
+        if (!out) if (testProcess(q,c)!=-3) out=113;
+        if (!out) if ((items.value.size()!=2)||(items.value.at(1).v!=2)) out=114;
+        items.bulk(100,2);//Mniej wartości niż próg - konwersja w jednym wątku.
+        if (!out) if (testProcess(q,c)!=-3) out=115;
+        if (!out) if ((items.value.size()!=2)||(items.value.at(1).v!=2)) out=116;
+        items.bulk(0);
+        if (!out) if (testProcess(q,c)!=-3) out=117;
+        if (!out) if ((items.value.size()!=2)||(items.value.at(1).v!=2)) out=118;
+        {
+            testThrowing t;
+            if (!out) if (ict::options::convert("!",t)!=-1) out=119;
+        }
+        {//Błąd w finish() jednej opcji nie pomija finish() kolejnych opcji.
+            ict::options::vector<int> next(q,"m","more","","Opis more.");
+            items.bulk(1,1);
+            next.bulk(1,1);
+            if (!out) if (testProcess(q,{"test","-i!","-m1","-m2"})!=-3) out=122;
+            if (!out) if ((next.value.size()!=2)||(next.value.at(1)!=2)) out=123;
+        }
+    }
+    {//Pula wątków - każde zadanie jest wykonywane raz, także przy równoczesnych wywołaniach (druga pula jest zajęta).
+        std::vector<std::atomic<int>> hits(2000);
+        auto task=[&hits](std::size_t i){hits[i]++;};
+        std::thread other([&task](){
+            for (int k=0;k<50;k++) ict::options::runParallel(1000,4,task);
+        });
+        for (int k=0;k<50;k++) ict::options::runParallel(1000,4,task);
+        other.join();
+        ict::options::runParallel(1000,1,task);
+        ict::options::runParallel(0,4,task);
+        if (!out) for (std::size_t i=0;i<1000;i++) if (hits[i]!=101){
+            out=120;
+            break;
+        }
+        if (!out) for (std::size_t i=1000;i<2000;i++) if (hits[i]){
+            out=121;
+            break;
+        }
+    }
+    return(out);
+}
+REGISTER_TEST(options,tc34){
+    int out=0;
+    ict::options::parser p;
+    ict::options::counter verbose(p,"v","verbose","","Opis verbose.");
+    ict::options::single<int> port(p,"p","port","80","Opis port.");
+    ict::options::vector<std::string> files(p,"f","file","","Opis file.");
+    ict::options::single<std::string> name(p,"","serwer-nazwa","","Opis serwer-nazwa.");
+    ict::options::single<int> limit(p,"","limit","1","Opis limit.");
+    std::string config(testFile("# komentarz\n  verbose\r\nport = 8080\nfile = \"a b\"\nfile=c\n[serwer]\n; komentarz\nnazwa = alfa\n[]\nlimit=5"));
+    std::string unknown(testFile("port=1\nnieznana = 1\n"));
+    std::string counter(testFile("verbose = 2\n"));
+    std::string prefix(testFile("po = 5\n"));
+    std::string empty(testFile("= 7\n"));
+    std::vector<std::string> a({"test","-p","1","-f","d","-v","-v"});
+    if (config.empty()||unknown.empty()||counter.empty()) out=101;
+    p.setConfigFile(config);
+    if (!out) if (testProcess(p,{"test"})) out=102;
+    if (!out) if ((verbose.value!=1)||(verbose.getSource()!=ict::options::source_file)) out=103;
+    if (!out) if ((port.value!=8080)||(port.getSource()!=ict::options::source_file)) out=104;
+    if (!out) if ((files.value.size()!=2)||(files.value.at(0)!="a b")||(files.value.at(1)!="c")) out=105;
+    if (!out) if (name.value!="alfa") out=106;
+    if (!out) if (limit.value!=5) out=107;
+    if (!out) if (testProcess(p,a)) out=108;
+    if (!out) if ((verbose.value!=2)||(verbose.getSource()!=ict::options::source_argv)) out=109;
+    if (!out) if ((port.value!=1)||(port.counter!=1)||(port.getSource()!=ict::options::source_argv)) out=110;
+    if (!out) if ((files.value.size()!=1)||(files.value.at(0)!="d")) out=111;
+    if (!out) if ((name.value!="alfa")||(limit.value!=5)||(limit.getSource()!=ict::options::source_file)) out=112;
+    p.setConfigFile(unknown);
+    if (!out) if (testProcess(p,{"test"})!=-1) out=113;
+    p.setConfigFile(counter);
+    if (!out) if (testProcess(p,{"test"})!=-1) out=114;
+    p.setConfigFile(prefix);
+    if (!out) if (testProcess(p,{"test"})!=-1) out=118;//Skróty nazw nie są akceptowane.
+    p.setConfigFile(empty);
+    if (!out) if (testProcess(p,{"test"})!=-1) out=119;
+    p.setConfigFile("/nie/istniejacy/plik");
+    if (!out) if (testProcess(p,{"test"})!=-4) out=115;
+    p.setConfigFile("");
+    if (!out) if (testProcess(p,{"test"})) out=116;
+    if (!out) if ((port.value!=80)||(port.getSource()!=ict::options::source_default)) out=117;
+    for (const std::string & f : {config,unknown,counter,prefix,empty}) if (!f.empty()) unlink(f.c_str());
+    return(out);
+}
+REGISTER_TEST(options,tc35){
+    int out=0;
+    ict::options::parser p;
+    ict::options::counter verbose(p,"v","verbose","","Opis verbose.");
+    ict::options::counter quiet(p,"q","quiet","","Opis quiet.");
+    ict::options::single<int> port(p,"p","serwer-port","80","Opis serwer-port.");
+    ict::options::single<std::string> name(p,"n","name","","Opis name.");
+    ict::options::vector<int> numbers(p,"x","number","","Opis number.");
+    std::string config(testFile("serwer-port = 1\nname = plik\n"));
+    std::vector<std::string> a({"test","-p","3"});
+    name.setEnv("ICT_OPTIONS_TEST_NAZWA");
+    setenv("ICT_OPTIONS_TEST_SERWER_PORT","2",1);
+    setenv("ICT_OPTIONS_TEST_VERBOSE","1",1);
+    setenv("ICT_OPTIONS_TEST_QUIET","",1);
+    setenv("ICT_OPTIONS_TEST_NUMBER","7",1);
+    setenv("ICT_OPTIONS_TEST_NAZWA","alfa beta",1);
+    if (config.empty()) out=101;
+    if (!out) if (testProcess(p,{"test"})) out=102;
+    if (!out) if ((port.value!=80)||(verbose.value!=0)) out=103;//Brak przedrostka - tylko jawnie ustawione zmienne.
+    if (!out) if ((name.value!="alfa beta")||(name.getSource()!=ict::options::source_env)) out=104;
+    p.setEnvPrefix("ICT_OPTIONS_TEST_");
+    p.setConfigFile(config);
+    if (!out) if (testProcess(p,{"test"})) out=105;
+    if (!out) if ((port.value!=2)||(port.counter!=1)||(port.getSource()!=ict::options::source_env)) out=106;
+    if (!out) if ((verbose.value!=1)||(quiet.value!=0)) out=107;
+    if (!out) if ((numbers.value.size()!=1)||(numbers.value.at(0)!=7)) out=108;
+    if (!out) if (name.value!="alfa beta") out=109;
+    if (!out) if (testProcess(p,a)) out=110;
+    if (!out) if ((port.value!=3)||(port.getSource()!=ict::options::source_argv)) out=111;
+    setenv("ICT_OPTIONS_TEST_NUMBER","x",1);
+    if (!out) if (testProcess(p,{"test"})!=-3) out=112;
+    for (const char * e : {"ICT_OPTIONS_TEST_SERWER_PORT","ICT_OPTIONS_TEST_VERBOSE","ICT_OPTIONS_TEST_QUIET","ICT_OPTIONS_TEST_NUMBER","ICT_OPTIONS_TEST_NAZWA"}) unsetenv(e);
+    if (!out) if (testProcess(p,{"test"})) out=113;
+    if (!out) if ((port.value!=1)||(port.getSource()!=ict::options::source_file)) out=114;
+    if (!out) {
+        ict::options::single<int> shortOnly(p,"s","","5","Opis s.");
+        setenv("ICT_OPTIONS_TEST_","42",1);
+        if (testProcess(p,{"test"})||(shortOnly.value!=5)) out=115;//Opcja bez długiej nazwy nie ma zmiennej.
+        unsetenv("ICT_OPTIONS_TEST_");
+    }
+    if (!out) {
+        ict::options::counter dot(p,"","a.b","","Opis a.b.");
+        ict::options::counter dash(p,"","a-b","","Opis a-b.");
+        if (testProcess(p,{"test"})!=-1) out=116;//Ta sama zmienna ICT_OPTIONS_TEST_A_B.
+    }
+    if (!out) if (testProcess(p,{"test"})) out=117;
+    if (!config.empty()) unlink(config.c_str());
+    return(out);
+}
+REGISTER_TEST(options,tc36){
+    int out=0;
+    ict::options::parser p;
+    ict::options::counter a(p,"v","verbose","","Verbose.",{{"pl","Gadatliwy."}});
+    ict::options::vector<std::string> f(p,"f","file","x\ny","Files.",{},false);
+    ict::options::single<int> t(p,"","timeout","10","Timeout.");
+    std::ostringstream os;
+    const std::string * text=&p.helpText();
+    if (*text!=
+        "-f,--file <optional param> Files. Default: \"x\",\"y\".\n"
+        "-v,--verbose Verbose.\n"
+        "--timeout <mandatory param> Timeout. Default: \"10\".\n"
+    ) out=101;
+    if (!out) if (p.helpText("pl").find("-v,--verbose Gadatliwy.\n")==std::string::npos) out=102;
+    if (!out) if (&p.helpText()!=text) out=103;
+    p.help(os);
+    if (!out) if (os.str()!=*text) out=104;
+    if (!out) {
+        ict::options::counter b(p,"b","","","Short.");
+        if (p.helpText().compare(0,10,"-b Short.\n")) out=105;
+    }
+    if (!out) if (p.helpText().find("-b")!=std::string::npos) out=106;
+    if (!out) {//Stały kontekst - tekst pomocy z wielu wątków naraz.
+        const ict::options::parser & c(p);
+        std::atomic<int> errors(0);
+        std::vector<std::thread> readers;
+        for (const char * l : {"de","fr","pl","de"}) readers.emplace_back([&c,&errors,l](){
+            for (int k=0;k<100;k++){
+                std::ostringstream s;
+                c.help(s,l);
+                if (s.str().find("--timeout")==std::string::npos) errors++;
+            }
+        });
+        for (std::thread & r : readers) r.join();
+        if (errors) out=107;
+    }
+    if (!out) {
+        ict::options::counter b(p,"b","","","Short.");
+        const ict::options::parser & c(p);
+        if (c.helpText().find("-b")!=std::string::npos) out=108;//Bez finalize() - nowa opcja nie jest uwzględniana.
+        p.finalize();
+        if (c.helpText().compare(0,10,"-b Short.\n")) out=109;
+    }
+    return(out);
+}
+REGISTER_TEST(options,tc37){
+    int out=0;
+    ict::options::parser p;
+    ict::options::counter a(p,"v","verbose","","Verbose.",{{"pl","Gadatliwy."},{std::string("de"),"Gesprächig."}});
+    ict::options::single<int> t(p,"t","timeout","","Timeout.");
+    std::string catalog(testFile("# Katalog\ntimeout = Default timeout.\n[pl]\ntimeout = \"Limit czasu.\"\n[de]\nverbose = Ausführlich.\n"));
+    if (ict::options::locale_id("pl")!=ict::options::locale_id(std::string("pl"))) out=101;
+    if (!out) if (ict::options::locale_id("pl")==ict::options::locale_id("de")) out=102;
+    if (!out) if (ict::options::locale_id("pl").name()!="pl") out=103;
+    if (!out) if (!ict::options::locale_id("").empty()||(ict::options::locale_id().get()!=0)) out=104;
+    if (!out) if (a.getDescription().at(0).locale!="pl") out=105;
+    if (!out) if (sizeof(ict::options::description_t)>=2*sizeof(std::string)) out=106;
+    if (!out) if (p.helpText("pl")!="-t,--timeout <mandatory param> Timeout.\n-v,--verbose Gadatliwy.\n") out=107;
+    p.setCatalog(catalog);
+    if (!out) if (p.getCatalog()!=catalog) out=108;
+    if (!out) if (p.helpText("pl")!="-t,--timeout <mandatory param> Limit czasu.\n-v,--verbose Gadatliwy.\n") out=109;
+    if (!out) if (p.helpText("de")!="-t,--timeout <mandatory param> Timeout.\n-v,--verbose Ausführlich.\n") out=110;
+    if (!out) if (p.helpText()!="-t,--timeout <mandatory param> Default timeout.\n-v,--verbose Verbose.\n") out=111;
+    if (!out) if (&p.helpText("fr")!=&p.helpText()) out=112;//Nieznana lokalizacja - tekst domyślny.
+    if (!out) {
+        ict::options::locale_id id;
+        if (ict::options::locale_id::find("fr",id)) out=114;
+        if (!out) if ((!ict::options::locale_id::find("pl",id))||(id!=ict::options::locale_id("pl"))) out=115;
+    }
+    unlink(catalog.c_str());
+    p.setCatalog("/nonexistent/catalog");
+    if (!out) if (p.helpText("pl")!="-t,--timeout <mandatory param> Timeout.\n-v,--verbose Gadatliwy.\n") out=113;
+    return(out);
+}
+REGISTER_TEST(options,tc38){
+    int out=0;
+    ict::options::parser p;
+    ict::options::counter a(p,"v","verbose","","A.");
+    ict::options::counter b(p,"vw","verbose,loud","","B.");
+    ict::options::counter c(p,"","","","C.");
+    std::vector<std::string> args({"test","-w","--param-2","-v"});
+    {
+        ict::options::counter removed(p,"x","extra","","Removed before names are assigned.");
+    }
+    if (p.helpText()!="-v,--verbose A.\n-w,--loud B.\n--param-1 C.\n") out=101;
+    if (!out) {
+        ict::options::counter d(p,"w","","","D.");
+        ict::options::counter e(p,"","param-1,","","E.");
+        if (p.helpText()!="-v,--verbose A.\n-w,--loud B.\n--param-1 C.\n--param-2 D.\n--param-3 E.\n") out=102;
+        if (!out) if (testProcess(p,args)) out=103;
+        if (!out) if ((a.value!=1)||(b.value!=1)||(d.value!=1)) out=104;
+    }
+    if (!out) if (p.helpText()!="-v,--verbose A.\n-w,--loud B.\n--param-1 C.\n") out=105;
+    if (!out) {
+        ict::options::counter f(p,"x","extra","","F.");
+        p.finalize();
+        if (p.helpText()!="-v,--verbose A.\n-w,--loud B.\n-x,--extra F.\n--param-1 C.\n") out=106;
+    }
+    for (int k=0;(k<1500)&&(!out);k++){//Nazwy 'param-N' usuniętych opcji są przydzielane ponownie (bez wyczerpania limitu).
+        ict::options::counter g(p,"","","","G.");
+        if (p.helpText()!="-v,--verbose A.\n-w,--loud B.\n--param-1 C.\n--param-2 G.\n") out=107;
+    }
+    return(out);
+}
+REGISTER_TEST(options,tc39){
+    int out=0;
+    ict::options::counting_resource resource;
+    ict::options::parser p(&resource);
+    ict::options::single<int> port(p,"p","port","80","Port.");
+    ict::options::pmr::vector<std::pmr::string> files(p,"f","file","","Files.");
+    std::vector<std::string> a({"test","-p","8080","-f","a-rather-long-file-name-without-sso.txt","x","y"});
+    std::ostringstream os;
+    p.setStats(true,true);
+    if (!p.getStats()) out=101;
+    if (!out) if (testProcess(p,a)) out=102;
+    if (!out) {
+        const ict::options::stats_t & st(p.stats());
+        if ((st.process.count!=1)||(st.registration.count!=1)||(st.table.count!=1)||(st.clear.count!=1)) out=103;
+        if (!out) if ((st.parse.count!=1)||(st.env.count!=1)||(st.config.count!=0)||(st.finish.count!=1)) out=104;
+        if (!out) if ((st.notOptions.count!=2)||(st.conversion.count!=2)||(st.failures!=0)) out=105;
+        if (!out) if (st.conversions.size()!=2) out=106;
+        if (!out) if (st.conversions.at("ict::options::single<int>").count!=1) out=107;
+        if (!out) if ((st.allocations==0)||(st.allocatedBytes<a[4].size())) out=108;
+        if (!out) if (st.process.ns<st.parse.ns) out=109;
+    }
+    a[2]="x";
+    if (!out) if (testProcess(p,a)!=-3) out=110;
+    if (!out) if ((p.stats().process.count!=2)||(p.stats().table.count!=1)||(p.stats().failures!=1)) out=111;
+    if (!out) if (p.stats().conversions.at("ict::options::single<int>").failures!=1) out=112;
+    p.traceDump(os);
+    if (!out) if (os.str().rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[{\"name\":\"registration\"",0)!=0) out=113;
+    if (!out) if (os.str().find("\"name\":\"parse\",\"cat\":\"options\",\"ph\":\"X\"")==std::string::npos) out=114;
+    p.setStats(false);
+    if (!out) if (testProcess(p,{"test"})||(p.stats().process.count!=2)) out=115;
+    p.resetStats();
+    if (!out) if ((p.stats().process.count!=0)||!p.stats().conversions.empty()) out=116;
+    if (!out) if (&ict::options::stats()!=&ict::options::defaultParser().stats()) out=117;
+    {
+        ict::options::parser q;
+        ict::options::vector<int> numbers(q,"n","number","","Numbers.");
+        std::vector<std::string> c({"test","-n","1","-n","2","-n","x"});
+        numbers.bulk(1,1);
+        q.setStats(true);
+        if (!out) if (testProcess(q,c)!=-3) out=118;
+        if (!out) if ((q.stats().failures!=1)||(q.stats().conversions.size()!=1)||(q.stats().conversions.begin()->second.failures!=1)) out=119;
+        c[6]="3";
+        q.resetStats();
+        if (!out) if (testProcess(q,c)||(numbers.value.size()!=3)||(numbers.value.at(2)!=3)) out=120;
+        if (!out) if ((q.stats().failures!=0)||(q.stats().conversions.size()!=1)||(q.stats().conversions.begin()->second.ns==0)) out=121;
+    }
+    return(out);
+}
+REGISTER_TEST(options,tc40){
+    int out=0;
+    ict::options::parser p;
+    ict::options::counter verbose(p,"v","verbose","","Opis verbose.");
+    ict::options::single<int> port(p,"p","port","80","Opis port.");
+    ict::options::vector<std::string> files(p,"f","file","","Opis file.");
+    ict::options::vector<int> ids(p,"i","id","","Opis id.");
+    std::vector<std::string> a({"test","-v","-p","8080","-f","a","-vf","b","-i","1","-i","2","-i","3"});
+    std::string log;
+    int ends=0;
+    int endResult=0;
+    auto onVerbose=[&log](ict::options::interface *,const ict::options::counter_t & value){
+        log+="v"+std::to_string(value)+";";
+        return(0);
+    };
+    auto onPort=[&log,&port](ict::options::interface * option,const int & value){
+        log+="p"+std::to_string(value)+((option==&port)?";":"?;");
+        return((value<0)?1:0);
+    };
+    auto onFile=[&log](ict::options::interface *,const std::string & value){
+        log+="f"+value+";";
+        return(0);
+    };
+    auto onId=[&log,&ids](ict::options::interface *,const int & value){
+        log+="i"+std::to_string(value)+"/"+std::to_string(ids.value.size())+";";
+        return(0);
+    };
+    auto onEnd=[&ends,&endResult](ict::options::interface * option,const std::string_view &){
+        if (!option) ends++;
+        return(endResult);
+    };
+    verbose.setObserver(ict::options::observer_t<ict::options::counter_t>::wrap(onVerbose));
+    port.setObserver(ict::options::observer_t<int>::wrap(onPort));
+    files.setObserver(ict::options::observer_t<std::string>::wrap(onFile));
+    ids.setObserver(ict::options::observer_t<int>::wrap(onId));
+    ids.bulk(1,1);
+    p.setEndCallback(ict::options::callback_t::wrap(onEnd));
+    if (testProcess(p,a)) out=101;
+    if (!out) if (log!="v1;p8080;fa;v2;fb;i1/3;i2/3;i3/3;") out=102;
+    if (!out) if (ends!=1) out=103;
+    if (!out) if (!p.getEndCallback()) out=104;
+    a[3]="-1";
+    if (!out) if (testProcess(p,a)!=-3) out=105;
+    if (!out) if (ends!=1) out=106;
+    endResult=7;
+    if (!out) if (testProcess(p,{"test"})!=7) out=107;
+    if (!out) if (ends!=2) out=108;
+    return(out);
+}
 #endif
 //===========================================
\ No newline at end of file
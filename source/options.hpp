@@ -38,15 +38,62 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //============================================
 #include <string>
 #include <vector>
+#include <memory>
 #include <sstream>
+#include <string_view>
 #include <type_traits>
+#include <charconv>
+#include <stdexcept>
+#include <memory_resource>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include <atomic>
+#include <map>
+#include <ostream>
 //============================================
 namespace ict { namespace  options { 
 //===========================================
+//! 
+//! @brief Identyfikator lokalizacji (języka) - nazwy lokalizacji są przechowywane raz (w globalnej tablicy), a opisy opcji 
+//! przechowują tylko ich numery.
+//! 
+class locale_id {
+private:
+    //! Numer lokalizacji (0 - domyślna, pusta nazwa).
+    std::uint32_t id=0;
+public:
+    //! Konstruktor (domyślna lokalizacja).
+    locale_id(){}
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param name Nazwa lokalizacji (dodawana do globalnej tablicy, jeśli jej tam nie ma).
+    //! 
+    locale_id(const std::string & name):locale_id(std::string_view(name)){}
+    locale_id(const char * name):locale_id(std::string_view(name)){}
+    explicit locale_id(const std::string_view & name);
+    //! 
+    //! @brief Wyszukuje lokalizację (bez dodawania jej do globalnej tablicy).
+    //! 
+    //! @param name Nazwa lokalizacji.
+    //! @param out Identyfikator lokalizacji (jeśli została znaleziona).
+    //! @return Informacja, czy lokalizacja została znaleziona.
+    //! 
+    static bool find(const std::string_view & name,locale_id & out);
+    //! Zwraca numer lokalizacji.
+    std::uint32_t get() const {return(id);}
+    //! Zwraca nazwę lokalizacji.
+    const std::string & name() const;
+    //! Informacja, czy to domyślna lokalizacja.
+    bool empty() const {return(id==0);}
+    bool operator==(const locale_id & other) const {return(id==other.id);}
+    bool operator!=(const locale_id & other) const {return(id!=other.id);}
+};
 //! Struktura przechowująca opis dla danego języka.
 struct description_t{
     //! Wskazanie języka - jeśli puste, to domysłny opis.
-    std::string locale;
+    locale_id locale;
     //! Opis w danym języku.
     std::string desc;
 };
@@ -54,9 +101,576 @@ struct description_t{
 typedef std::vector<description_t> locale_desc_t;
 //! Typ przechowujący argumenty funkcji main, które nie zostały rozpozanane jako opcje.
 typedef std::vector<std::string> notOption_t;
+//! Typ przechowujący argumenty funkcji main, które nie zostały rozpozanane jako opcje (widoki wskazujące na argumenty, bez kopiowania).
+typedef std::pmr::vector<std::string_view> notOptionView_t;
+//! Sposób przechowywania argumentów, które nie są opcjami (maska bitowa).
+enum store_t : unsigned char {
+    //! Argumenty nie są przechowywane.
+    store_none=0,
+    //! Przechowywane są widoki (ict::options::notOptionView_t) - ważne tak długo, jak długo istnieją argumenty przekazane do parsera.
+    store_view=1,
+    //! Przechowywane są kopie (ict::options::notOption_t).
+    store_copy=2,
+    //! Przechowywane są widoki i kopie (domyślnie).
+    store_all=3
+};
 //! Typ zliczający liczbę wystąpienia danej opcji.
 typedef unsigned int counter_t;
+//! Rodzaj opcji (używany zamiast porównywania typów w postaci tekstu).
+enum kind_t : unsigned char {
+    //! Opcja bez wartości (ict::options::counter).
+    kind_counter=0,
+    //! Opcja z pojedynczą wartością (ict::options::single).
+    kind_single,
+    //! Opcja z zestawem wartości (ict::options::vector).
+    kind_vector
+};
+//! Rodzaj argumentu opcji.
+enum argument_t : unsigned char {
+    //! Opcja bez argumentu.
+    argument_none=0,
+    //! Opcja z obowiązkowym argumentem.
+    argument_required,
+    //! Opcja z nieobowiązkowym argumentem.
+    argument_optional
+};
+//! Źródło wartości opcji (w kolejności ważności - wartości z ważniejszego źródła zastępują wartości z mniej ważnego).
+enum source_t : unsigned char {
+    //! Wartość domyślna.
+    source_default=0,
+    //! Plik konfiguracyjny (patrz ict::options::parser::setConfigFile()).
+    source_file,
+    //! Zmienne środowiskowe (patrz ict::options::interface::setEnv() i ict::options::parser::setEnvPrefix()).
+    source_env,
+    //! Argumenty funkcji main.
+    source_argv
+};
+//! Znacznik konstruktora opcji, która nie jest rejestrowana w żadnym kontekście parsera (np. opcja ze schematu).
+struct unregistered_t {};
+//! Znacznik konstruktora opcji, która nie jest rejestrowana w żadnym kontekście parsera.
+inline constexpr unregistered_t unregistered{};
 //===========================================
+//! Typy tekstowe (std::basic_string z dowolnym alokatorem, np. std::pmr::string).
+template <class Value> struct is_string : public std::false_type {};
+template <class Traits,class Alloc> struct is_string<std::basic_string<char,Traits,Alloc>> : public std::true_type {};
+//! Typy z własną konwersją z tekstu (metoda int parse(const std::string_view &) zwracająca 0 w przypadku sukcesu).
+template <class Value,class=void> struct is_parsable : public std::false_type {};
+template <class Value> struct is_parsable<Value,std::void_t<decltype(std::declval<Value&>().parse(std::declval<const std::string_view&>()))>> : public std::true_type {};
+//! Typy liczbowe konwertowane przez std::from_chars() (bez typów znakowych i bool, które są konwertowane przez strumień).
+template <class Value> struct is_from_chars : public std::integral_constant<bool,
+    (std::is_integral<Value>::value&&!std::is_same<Value,bool>::value&&!std::is_same<Value,char>::value&&
+    !std::is_same<Value,signed char>::value&&!std::is_same<Value,unsigned char>::value&&
+    !std::is_same<Value,wchar_t>::value&&!std::is_same<Value,char16_t>::value&&!std::is_same<Value,char32_t>::value)
+#if defined(__cpp_lib_to_chars)
+    ||std::is_floating_point<Value>::value
+#endif
+> {};
+//! Kontenery z metodą reserve() (np. std::vector, ale nie std::list czy std::deque).
+template <class Container,class=void> struct has_reserve : public std::false_type {};
+template <class Container> struct has_reserve<Container,std::void_t<decltype(std::declval<Container&>().reserve(std::size_t()))>> : public std::true_type {};
+//! 
+//! @brief Konwertuje wartość w postaci tekstu na wartość danego typu.
+//! 
+//! Typy liczbowe są konwertowane przez std::from_chars() - cały tekst musi być poprawną liczbą (dopuszczalny jest znak '+'),
+//! a wartość musi mieścić się w zakresie typu. Dla std::string_view podstawiany jest widok (bez kopiowania).
+//! Typy wyliczeniowe są konwertowane jak ich typ bazowy. Typy z metodą parse() (patrz ict::options::is_parsable) konwertują tekst same. 
+//! Pozostałe typy są konwertowane przez operator>>. Wyjątek zgłoszony podczas konwersji (w tym przez parse() lub operator>> typu użytkownika)
+//! jest przechwytywany i traktowany jak błąd - funkcja nie zgłasza wyjątków.
+//! 
+//! @param val Wartość w postaci tekstu.
+//! @param target Zmienna, do której ma być podstawiona wartość.
+//! @return Jeśli:
+//!  @li 0 - wartość ustawiona poprawnie;
+//!  @li -1 - wystąpił błąd.
+//! 
+template <class Value> int convert(const std::string_view & val,Value & target){
+    try{
+        if constexpr (is_string<Value>::value){
+            target.assign(val.data(),val.size());
+        } else if constexpr (std::is_same<Value,std::string_view>::value){
+            target=val;
+        } else if constexpr (is_parsable<Value>::value){
+            if (target.parse(val)) return(-1);
+        } else if constexpr (is_from_chars<Value>::value){
+            const char * first=val.data();
+            const char * last=val.data()+val.size();
+            Value v{};
+            if ((first!=last)&&(*first=='+')){
+                first++;
+                if ((first!=last)&&(*first=='-')) return(-1);
+            }
+            std::from_chars_result r=std::from_chars(first,last,v);
+            if ((r.ec!=std::errc())||(r.ptr!=last)) return(-1);
+            target=v;
+        } else if constexpr (std::is_enum<Value>::value){
+            typename std::underlying_type<Value>::type v{};
+            if (convert(val,v)) return(-1);
+            target=static_cast<Value>(v);
+        } else {
+            std::istringstream s{std::string(val)};
+            s>>target;
+        }
+    } catch (...){
+        return(-1);
+    }
+    return(0);
+}
+//===========================================
+class interface;
+//! Pozycja w tablicy opcji.
+struct entry_t {
+    //! Obiekt obsługujący opcję (nullptr - opcja nie została znaleziona).
+    interface * ptr=nullptr;
+    //! Rodzaj argumentu opcji.
+    argument_t argument=argument_none;
+};
+//! Tablica opcji, z której korzysta parser argumentów.
+class lookup {
+public:
+    virtual ~lookup(){}
+    //! 
+    //! @brief Wyszukuje krótką opcję.
+    //! 
+    //! @param c Krótka nazwa opcji.
+    //! @return Pozycja w tablicy opcji.
+    //! 
+    virtual entry_t findShort(char c) const=0;
+    //! 
+    //! @brief Wyszukuje długą opcję.
+    //! 
+    //! @param name Długa nazwa (lub jednoznaczny skrót nazwy) opcji.
+    //! @return Pozycja w tablicy opcji.
+    //! 
+    virtual entry_t findLong(const std::string_view & name) const=0;
+    //! 
+    //! @brief Wyszukuje długą opcję po dokładnej nazwie (bez skrótów - np. dla pliku konfiguracyjnego).
+    //! 
+    //! @param name Długa nazwa opcji.
+    //! @return Pozycja w tablicy opcji.
+    //! 
+    virtual entry_t findExact(const std::string_view & name) const=0;
+    //! 
+    //! @brief Zwraca liczbę opcji w tablicy (np. dla zmiennych środowiskowych).
+    //! 
+    //! @return Liczba opcji.
+    //! 
+    virtual std::size_t optionCount() const=0;
+    //! 
+    //! @brief Zwraca opcję z tablicy.
+    //! 
+    //! @param k Indeks opcji (mniejszy od optionCount()).
+    //! @return Wskaźnik do obiektu obsługującego opcję.
+    //! 
+    virtual interface * optionAt(std::size_t k) const=0;
+};
+//! 
+//! @brief Funkcja zwrotna otrzymująca opcję i wartość (wskaźnik do funkcji i kontekst - bez alokacji pamięci).
+//! 
+//! Jako funkcja obserwująca wartości opcji (patrz np. ict::options::single::setObserver()) jest wywoływana w trakcie parsowania, 
+//! od razu po konwersji wartości, z opcją i przekonwertowaną wartością (dla ict::options::vector - z dodanym elementem, 
+//! dla ict::options::counter - z liczbą wystąpień). Jeśli zwróci wartość różną od 0, to wartość jest traktowana jako niepoprawna (parser zwraca -3).
+//! 
+//! @tparam Value Typ wartości.
+//! 
+template <class Value> class observer_t {
+public:
+    //! Typ funkcji.
+    typedef int (*function_t)(void * context,interface * option,const Value & value);
+private:
+    //! Funkcja.
+    function_t function=nullptr;
+    //! Kontekst przekazywany do funkcji.
+    void * context=nullptr;
+public:
+    //! Konstruktor (brak funkcji).
+    observer_t(){}
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param function Funkcja.
+    //! @param context Kontekst przekazywany do funkcji.
+    //! 
+    observer_t(function_t function,void * context=nullptr):function(function),context(context){}
+    //! 
+    //! @brief Tworzy funkcję zwrotną wywołującą obiekt funkcyjny (np. lambdę) - obiekt musi istnieć tak długo, jak funkcja zwrotna.
+    //! 
+    //! @param f Obiekt funkcyjny wywoływany z parametrami (interface * option,const Value & value) i zwracający int.
+    //! @return Funkcja zwrotna.
+    //! 
+    template <class Function> static observer_t wrap(Function & f){
+        return(observer_t([](void * context,interface * option,const Value & value)->int{
+            return((*static_cast<Function*>(context))(option,value));
+        },const_cast<void*>(static_cast<const void*>(&f))));
+    }
+    //! Informuje, czy funkcja jest ustawiona.
+    explicit operator bool() const {return(function!=nullptr);}
+    //! Wywołuje funkcję.
+    int operator()(interface * option,const Value & value) const {return(function(context,option,value));}
+};
+//! 
+//! @brief Funkcja zwrotna wywoływana przez parser (patrz ict::options::observer_t).
+//! 
+//! Funkcja otrzymuje opcję (nullptr - argument, który nie jest opcją) i wartość w postaci widoku.
+//! Jeśli zwróci wartość różną od 0, to parsowanie jest przerywane, a parser zwraca tę wartość.
+//! 
+typedef observer_t<std::string_view> callback_t;
+//! 
+//! @brief Statystyki kontekstu parsera (zbierane po włączeniu - patrz ict::options::parser::setStats()).
+//! 
+//! Czasy są mierzone zegarem std::chrono::steady_clock (w nanosekundach).
+//! 
+struct stats_t {
+    //! Etap przetwarzania.
+    struct phase_t {
+        //! Liczba wykonań.
+        std::uint64_t count=0;
+        //! Łączny czas.
+        std::uint64_t ns=0;
+    };
+    //! Konwersja wartości dla danego typu opcji.
+    struct conversion_t {
+        //! Liczba konwersji.
+        std::uint64_t count=0;
+        //! Łączny czas (razem z konwersją w ict::options::interface::finish(), np. w trybie bulk()).
+        std::uint64_t ns=0;
+        //! Liczba błędów konwersji (razem z błędami ict::options::interface::finish()).
+        std::uint64_t failures=0;
+    };
+    //! Przydzielanie nazw opcjom (patrz ict::options::parser::finalize()).
+    phase_t registration;
+    //! Budowanie tablicy opcji.
+    phase_t table;
+    //! Przywracanie wartości domyślnych wszystkich opcji.
+    phase_t clear;
+    //! Wczytywanie pliku konfiguracyjnego.
+    phase_t config;
+    //! Wczytywanie zmiennych środowiskowych.
+    phase_t env;
+    //! Przetwarzanie argumentów (razem z konwersją wartości i zapisem argumentów, które nie są opcjami).
+    phase_t parse;
+    //! Zapis argumentów, które nie są opcjami.
+    phase_t notOptions;
+    //! Konwersja wartości (wszystkie typy opcji).
+    phase_t conversion;
+    //! Kończenie przetwarzania opcji (patrz ict::options::interface::finish()).
+    phase_t finish;
+    //! Budowanie tekstu pomocy.
+    phase_t help;
+    //! Całe wywołania process().
+    phase_t process;
+    //! Konwersje wartości według typów opcji (nazwa typu C++).
+    std::map<std::string,conversion_t> conversions;
+    //! Liczba błędów konwersji.
+    std::uint64_t failures=0;
+    //! Liczba alokacji z zasobu pamięci kontekstu w process() (tylko dla ict::options::counting_resource).
+    std::uint64_t allocations=0;
+    //! Liczba bajtów przydzielonych z zasobu pamięci kontekstu w process() (tylko dla ict::options::counting_resource).
+    std::uint64_t allocatedBytes=0;
+};
+//! 
+//! @brief Zasób pamięci liczący alokacje (przekazuje je do innego zasobu).
+//! 
+//! Użyty jako zasób pamięci kontekstu parsera pozwala liczyć alokacje w statystykach (ict::options::stats_t).
+//! 
+class counting_resource : public std::pmr::memory_resource {
+private:
+    //! Zasób pamięci, do którego są przekazywane alokacje.
+    std::pmr::memory_resource * upstream;
+    //! Liczba alokacji.
+    std::atomic<std::uint64_t> allocations{0};
+    //! Liczba przydzielonych bajtów.
+    std::atomic<std::uint64_t> bytes{0};
+    void * do_allocate(std::size_t size,std::size_t alignment) override {
+        allocations.fetch_add(1,std::memory_order_relaxed);
+        bytes.fetch_add(size,std::memory_order_relaxed);
+        return(upstream->allocate(size,alignment));
+    }
+    void do_deallocate(void * p,std::size_t size,std::size_t alignment) override {
+        upstream->deallocate(p,size,alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override {
+        return(this==&other);
+    }
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param upstream Zasób pamięci, do którego są przekazywane alokacje.
+    //! 
+    explicit counting_resource(std::pmr::memory_resource * upstream=std::pmr::get_default_resource()):upstream(upstream){}
+    //! Zwraca liczbę alokacji.
+    std::uint64_t getAllocations() const {return(allocations.load(std::memory_order_relaxed));}
+    //! Zwraca liczbę przydzielonych bajtów.
+    std::uint64_t getBytes() const {return(bytes.load(std::memory_order_relaxed));}
+};
+//! 
+//! @brief Kontekst parsera - przechowuje własny rejestr opcji i listę argumentów, które nie są opcjami.
+//! 
+//! Opcje rejestrowane w danym kontekście przechowują jego wyniki. Różne konteksty mogą być używane 
+//! jednocześnie w różnych wątkach (pojedynczy kontekst może być używany tylko przez jeden wątek naraz).
+//! Funkcje globalne (ict::options::process(), ict::options::help(), ict::options::noOptions()) 
+//! korzystają z kontekstu domyślnego (ict::options::defaultParser()).
+//! 
+class parser {
+private:
+    friend class interface;
+    //! Dane rejestru opcji (zdefiniowane w pliku źródłowym).
+    struct registry_t;
+    //! Zasób pamięci dla wartości opcji i argumentów, które nie są opcjami.
+    std::pmr::memory_resource * resource;
+    //! Rejestr opcji.
+    std::unique_ptr<registry_t> registry;
+    //! 
+    //! @brief Rejestruje obiekt do obsługi opcji.
+    //! 
+    //! @param ptr Wskaźnik do obiektu obsługującego opcję.
+    //! 
+    void registerOpt(interface*ptr);
+    //! 
+    //! @brief Wyrejestrowuje obiekt do obsługi opcji.
+    //! 
+    //! @param ptr Wskaźnik do obiektu obsługującego opcję.
+    //! 
+    void unregisterOpt(interface*ptr);
+    //! 
+    //! @brief Zapisuje wartość opcji z danego źródła (wartości z mniej ważnego źródła są najpierw usuwane).
+    //! 
+    //! @param ptr Wskaźnik do obiektu obsługującego opcję.
+    //! @param source Źródło wartości.
+    //! @param val Wartość.
+    //! @return Patrz ict::options::process()
+    //! 
+    int set(interface * ptr,source_t source,const std::string_view & val);
+    //! 
+    //! @brief Wczytuje plik konfiguracyjny.
+    //! 
+    //! @param table Tablica opcji.
+    //! @return Patrz ict::options::process()
+    //! 
+    int loadConfig(const lookup & table);
+    //! 
+    //! @brief Wczytuje wartości opcji ze zmiennych środowiskowych (jedno przejście przez environ).
+    //! 
+    //! @param table Tablica opcji.
+    //! @return Patrz ict::options::process()
+    //! 
+    int loadEnv(const lookup & table);
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param resource Zasób pamięci (np. std::pmr::monotonic_buffer_resource) używany przez kontener opcji ict::options::pmr::vector
+    //!  i listę widoków ict::options::notOptionView_t - musi istnieć dłużej niż kontekst parsera i jego opcje.
+    //! 
+    explicit parser(std::pmr::memory_resource * resource=std::pmr::get_default_resource());
+    parser(const parser &)=delete;
+    parser & operator=(const parser &)=delete;
+    //! Destruktor - odłącza opcje, które są nadal zarejestrowane.
+    virtual ~parser();
+    //! 
+    //! @brief Procesuje parametry funkcji main (lub dowolny inny wektor argumentów) w tym kontekście.
+    //! 
+    //! Patrz ict::options::process()
+    //! 
+    int process(int argc,char *const argv[]);
+    //! 
+    //! @brief Procesuje argumenty korzystając z zewnętrznej tablicy opcji (opcje z tej tablicy nie są czyszczone).
+    //! 
+    //! @param table Tablica opcji.
+    //! @param argc Liczba argumentów.
+    //! @param argv Argumenty.
+    //! @return Patrz ict::options::process()
+    //! 
+    int process(const lookup & table,int argc,char *const argv[]);
+    //! 
+    //! @brief Zwraca tekst pomocy dla opcji z tego kontekstu (najpierw przydziela nazwy nowym opcjom - patrz finalize()).
+    //! 
+    //! Patrz ict::options::help()
+    //! 
+    void help(std::ostream & os,const std::string & locale="");
+    //! 
+    //! @brief Zwraca tekst pomocy dla opcji z tego kontekstu (może być wywoływana jednocześnie w wielu wątkach).
+    //! 
+    //! Nie przydziela nazw - opcje zarejestrowane po ostatnim wywołaniu finalize() (lub process()) nie są uwzględniane.
+    //! 
+    //! Patrz ict::options::help()
+    //! 
+    void help(std::ostream & os,const std::string & locale="") const;
+    //! 
+    //! @brief Przydziela nazwy opcjom zarejestrowanym od poprzedniego wywołania (wywoływane przez process() i help()).
+    //! 
+    //! Rejestracja opcji tylko dodaje ją do listy, a nazwy są przydzielane dla wszystkich nowych opcji naraz - w kolejności 
+    //! rejestracji (pierwsza wolna nazwa z listy, a jeśli żadna nie jest wolna - 'param-N').
+    //! 
+    void finalize();
+    //! 
+    //! @brief Włącza lub wyłącza zbieranie statystyk (patrz ict::options::stats_t).
+    //! 
+    //! @param enable Informacja, czy statystyki są zbierane.
+    //! @param trace Informacja, czy są zapisywane zdarzenia etapów (patrz traceDump()).
+    //! 
+    void setStats(bool enable,bool trace=false);
+    //! 
+    //! @brief Zwraca informację, czy statystyki są zbierane.
+    //! 
+    bool getStats() const;
+    //! 
+    //! @brief Zwraca statystyki.
+    //! 
+    const stats_t & stats() const;
+    //! 
+    //! @brief Zeruje statystyki i usuwa zapisane zdarzenia.
+    //! 
+    void resetStats();
+    //! 
+    //! @brief Zapisuje zdarzenia etapów w formacie Chrome trace (JSON, do wczytania w chrome://tracing lub Perfetto).
+    //! 
+    //! Zapisywanych jest co najwyżej 65536 zdarzeń (kolejne są pomijane).
+    //! 
+    //! @param os Strumień wyjściowy.
+    //! 
+    void traceDump(std::ostream & os) const;
+    //! 
+    //! @brief Zwraca tekst pomocy dla opcji z tego kontekstu (najpierw przydziela nazwy nowym opcjom - patrz finalize()).
+    //! 
+    //! Tekst jest budowany raz dla danej lokalizacji i zapamiętywany do zmiany rejestru opcji (rejestracji lub usunięcia opcji).
+    //! 
+    //! @param locale Wskazanie lokalizacji (język itp.) 
+    //! @return Tekst pomocy (ważny do zmiany rejestru opcji).
+    //! 
+    const std::string & helpText(const std::string & locale="");
+    //! 
+    //! @brief Zwraca tekst pomocy dla opcji z tego kontekstu (może być wywoływana jednocześnie w wielu wątkach).
+    //! 
+    //! Nie przydziela nazw - opcje zarejestrowane po ostatnim wywołaniu finalize() (lub process()) nie są uwzględniane.
+    //! Zapamiętane teksty są budowane pod blokadą.
+    //! 
+    //! @param locale Wskazanie lokalizacji (język itp.) 
+    //! @return Tekst pomocy (ważny do zmiany rejestru opcji).
+    //! 
+    const std::string & helpText(const std::string & locale="") const;
+    //! 
+    //! @brief Udostępnia listę argumentów, które nie są opcjami (w tym kontekście).
+    //! 
+    //! Patrz ict::options::noOptions()
+    //! 
+    const notOption_t & noOptions() const;
+    //! 
+    //! @brief Udostępnia listę argumentów, które nie są opcjami (w tym kontekście), w postaci widoków wskazujących na argumenty.
+    //! 
+    //! Patrz ict::options::noOptionsView()
+    //! 
+    const notOptionView_t & noOptionsView() const;
+    //! 
+    //! @brief Ustawia sposób przechowywania argumentów, które nie są opcjami.
+    //! 
+    //! @param store Sposób przechowywania (domyślnie ict::options::store_all).
+    //! 
+    void setNoOptionsStore(store_t store);
+    //! 
+    //! @brief Zwraca sposób przechowywania argumentów, które nie są opcjami.
+    //! 
+    //! @return Sposób przechowywania.
+    //! 
+    store_t getNoOptionsStore() const;
+    //! 
+    //! @brief Włącza (lub wyłącza) obsługę plików odpowiedzi.
+    //! 
+    //! Argument '@plik' jest zastępowany argumentami z pliku (rozdzielonymi białymi znakami, z obsługą apostrofów,
+    //! cudzysłowów i znaku '\\'; plik może zawierać kolejne argumenty '@plik'). Plik jest mapowany w pamięci,
+    //! a argumenty (również wartości opcji typu std::string_view) wskazują na tę pamięć - do kolejnego wywołania
+    //! process() w tym kontekście (lub jego usunięcia).
+    //! 
+    //! @param enable Informacja, czy argumenty '@plik' mają być zastępowane zawartością pliku (domyślnie nie).
+    //! 
+    void setResponseFiles(bool enable);
+    //! 
+    //! @brief Informuje, czy obsługa plików odpowiedzi jest włączona.
+    //! 
+    bool getResponseFiles() const;
+    //! 
+    //! @brief Ustawia funkcję zwrotną wywoływaną dla każdego argumentu, który nie jest opcją (od razu, w trakcie parsowania).
+    //! 
+    //! Razem z ict::options::store_none (patrz setNoOptionsStore()) pozwala przetwarzać argumenty bez ich przechowywania.
+    //! 
+    //! @param callback Funkcja zwrotna (pusta - brak).
+    //! 
+    void setNoOptionCallback(const callback_t & callback);
+    //! 
+    //! @brief Ustawia plik konfiguracyjny wczytywany przez process() przed argumentami (wartości z argumentów mają pierwszeństwo).
+    //! 
+    //! Format pliku: linie 'nazwa = wartość' (lub sama 'nazwa' dla opcji bez wartości), gdzie nazwa jest pełną długą nazwą opcji (bez skrótów, pusta nazwa jest błędem).
+    //! Linia '[sekcja]' dodaje przedrostek 'sekcja-' do kolejnych nazw ('[]' - bez przedrostka). Linie zaczynające się od '#' lub ';'
+    //! są komentarzami. Wartość w cudzysłowach jest brana bez cudzysłowów. Plik jest mapowany w pamięci (jak pliki odpowiedzi).
+    //! 
+    //! @param path Ścieżka do pliku (pusta - brak pliku).
+    //! 
+    void setConfigFile(const std::string & path);
+    //! 
+    //! @brief Zwraca plik konfiguracyjny.
+    //! 
+    const std::string & getConfigFile() const;
+    //! 
+    //! @brief Ustawia katalog opisów opcji w różnych językach (wczytywany przez help() tylko dla żądanej lokalizacji).
+    //! 
+    //! Format pliku jak dla pliku konfiguracyjnego: sekcja '[lokalizacja]', a w niej linie 'długa nazwa opcji = opis'.
+    //! Opis z katalogu ma pierwszeństwo przed opisem podanym przy definicji opcji. Plik jest mapowany w pamięci tylko na czas
+    //! budowania tekstu pomocy (w pamięci pozostaje tylko tekst pomocy). Jeśli pliku nie można odczytać, to jest pomijany.
+    //! 
+    //! @param path Ścieżka do pliku (pusta - brak katalogu).
+    //! 
+    void setCatalog(const std::string & path);
+    //! 
+    //! @brief Zwraca katalog opisów opcji.
+    //! 
+    const std::string & getCatalog() const;
+    //! 
+    //! @brief Ustawia przedrostek nazw zmiennych środowiskowych dla opcji z tego kontekstu.
+    //! 
+    //! Opcje bez nazwy zmiennej (patrz ict::options::interface::setEnv()) są wiązane ze zmienną o nazwie: przedrostek 
+    //! i długa nazwa opcji wielkimi literami, w której znaki inne niż litery i cyfry są zastąpione przez '_' 
+    //! (np. przedrostek "APP_" i opcja '--serwer-port' - zmienna APP_SERWER_PORT). Opcje bez długiej nazwy nie są wiązane ze zmienną.
+    //! Jeśli dwie opcje są wiązane z tą samą zmienną (np. '--a.b' i '--a-b'), to process() zwraca -1.
+    //! Zmienne są wczytywane przez process() po pliku konfiguracyjnym, a przed argumentami (wartości z argumentów mają pierwszeństwo).
+    //! 
+    //! @param prefix Przedrostek (pusty - brak zmiennych dla opcji bez nazwy zmiennej).
+    //! 
+    void setEnvPrefix(const std::string & prefix);
+    //! 
+    //! @brief Zwraca przedrostek nazw zmiennych środowiskowych.
+    //! 
+    const std::string & getEnvPrefix() const;
+    //! 
+    //! @brief Ustawia funkcję zwrotną wywoływaną dla każdego wystąpienia opcji (po zapisaniu wartości opcji).
+    //! 
+    //! @param callback Funkcja zwrotna (pusta - brak).
+    //! 
+    void setOptionCallback(const callback_t & callback);
+    //! 
+    //! @brief Ustawia funkcję zwrotną wywoływaną po zakończeniu parsowania (po poprawnym przetworzeniu wszystkich opcji).
+    //! 
+    //! Funkcja jest wywoływana z opcją nullptr i pustą wartością, a wartość różna od 0 jest zwracana przez process().
+    //! 
+    //! @param callback Funkcja zwrotna (pusta - brak).
+    //! 
+    void setEndCallback(const callback_t & callback);
+    //! 
+    //! @brief Zwraca funkcję zwrotną wywoływaną po zakończeniu parsowania.
+    //! 
+    const callback_t & getEndCallback() const;
+    //! 
+    //! @brief Zwraca zasób pamięci używany przez ten kontekst.
+    //! 
+    //! @return Zasób pamięci.
+    //! 
+    std::pmr::memory_resource * getMemoryResource() const {return(resource);}
+};
+//! 
+//! @brief Zwraca domyślny kontekst parsera (używany przez funkcje globalne i opcje bez wskazanego kontekstu).
+//! 
+//! @return Domyślny kontekst parsera.
+//! 
+parser & defaultParser();
 //! 
 //! @brief Procesuje parametry funkcji main.
 //! 
@@ -64,8 +678,13 @@ typedef unsigned int counter_t;
 //! @param argv Drugi parametr funkcji main.
 //! @return int Zwraca:
 //!   @li 0 - jeśli sukces;
-//!   @li -1 - jeśli błąd - nierozpoznana opcja.
+//!   @li -1 - jeśli błąd - nierozpoznana opcja (lub niejednoznaczny skrót nazwy albo parametr przy opcji, która go nie przyjmuje),
+//!     albo dwie opcje powiązane z tą samą zmienną środowiskową - patrz ict::options::parser::setEnvPrefix().
 //!   @li -2 - jeśli błąd - brak parametru obowiązkowego.
+//!   @li -3 - jeśli błąd - niepoprawna wartość parametru;
+//!   @li -4 - jeśli błąd - nie można odczytać pliku odpowiedzi (lub zbyt głębokie zagnieżdżenie plików) - patrz ict::options::parser::setResponseFiles(),
+//!     albo pliku konfiguracyjnego - patrz ict::options::parser::setConfigFile() (błędy w pliku konfiguracyjnym są zgłaszane jak dla argumentów);
+//!   @li wartość zwrócona przez funkcję zwrotną (jeśli różna od 0) - patrz ict::options::parser::setNoOptionCallback().
 //! 
 int process(int argc,char *const argv[]);
 //! 
@@ -81,10 +700,36 @@ void help(std::ostream & os,const std::string & locale="");
 //! @return const notOption_t& 
 //! 
 const notOption_t & noOptions();
+//! 
+//! @brief Udostępnia listę argumentów z funkcji main, które nie są opcjami, w postaci widoków (bez kopiowania).
+//! 
+//! Widoki wskazują na argumenty przekazane do ict::options::process() - są ważne tak długo, jak długo istnieją te argumenty
+//! (dla argumentów funkcji main - do końca programu).
+//! 
+//! @return const notOptionView_t& 
+//! 
+const notOptionView_t & noOptionsView();
+//! 
+//! @brief Zwraca statystyki kontekstu domyślnego (patrz ict::options::parser::stats()).
+//! 
+//! @return Statystyki.
+//! 
+const stats_t & stats();
 //===========================================
 //! Podstawowy interfejs opcji.
 class interface {
 private:
+    friend class parser;
+    //! Kontekst parsera, w którym opcja jest zarejestrowana.
+    parser * owner=nullptr;
+    //! Krótka nazwa opcji przydzielona przy rejestracji (0 - brak).
+    char shortName=0;
+    //! Długa nazwa opcji przydzielona przy rejestracji (pusta - brak).
+    std::string longName;
+    //! Źródło wartości opcji.
+    source_t source=source_default;
+    //! Nazwa zmiennej środowiskowej (pusta - nazwa z przedrostka kontekstu, patrz ict::options::parser::setEnvPrefix()).
+    std::string envName;
     //! Przechowuje listę krótkich nazw opcji.
     std::string shortOption;
     //! Przechowuje listę długich nazw opcji (rozdzielone spacją lub przecinkiem).
@@ -93,12 +738,6 @@ private:
     std::string defaultValue;
     //! Przechowuje opis opcji.
     locale_desc_t description;
-    //! 
-    //! @brief Rejestruje obiekt do obsługi opcji.
-    //! 
-    //! @param ptr Wskaźnik do opbiektu obsługującego opcję.
-    //! 
-    static void registerOpt(interface*ptr);
 protected:
     //! 
     //! @brief Zapisuje wartość opcji.
@@ -109,22 +748,13 @@ protected:
     //!  @li 0 - wartość ustawiona poprawnie;
     //!  @li -1 - wystąpił błąd.
     //! 
-    template <class Value> int setValue(const std::string & val,Value & target){
-        try{
-            std::istringstream s(val);
-            s>>target;
-        } catch (...){
-            return(-1);
-        }
-        return(0);
-    }
-    int setValue(const std::string & val,std::string & target){
-        target.assign(val);
-        return(0);
+    template <class Value> int setValue(const std::string_view & val,Value & target){
+        return(convert(val,target));
     }
     //! 
     //! @brief Inicjuje parametr.
     //! 
+    //! @param owner Kontekst parsera, w którym opcja jest rejestrowana (nullptr - opcja nie jest rejestrowana i używa pierwszych nazw z list).
     //! @param shortOpt Lista krótkich nazw opcji (pierwsza wolna jest używana).
     //! @param longOpt Lista długich nazw opcji (rozdzielone spacją lub przecinkiem - pierwsza wolna jest używana).
     //! @param defaultVal Domyślna wartość (jeśli jest).
@@ -132,6 +762,7 @@ protected:
     //! @param localeDesc opis opcji (w róznych językach).
     //! 
     void init(
+        parser * owner,
         const std::string & shortOpt="",
         const std::string & longOpt="",
         const std::string & defaultVal="",
@@ -139,15 +770,17 @@ protected:
         const locale_desc_t & localeDesc={}
     );
 public:
+    //! Destruktor - wyrejestrowuje opcję z kontekstu parsera.
+    virtual ~interface();
     //! 
     //! @brief Zapisuje wartość opcji.
     //! 
-    //! @param val Wartość w postaci string do zapisania.
+    //! @param val Wartość w postaci tekstu do zapisania (parser przekazuje widok wskazujący na argument - bez kopiowania).
     //! @return Jeśli:
     //!  @li 0 - wartość ustawiona poprawnie;
     //!  @li -1 - wystąpił błąd.
     //! 
-    virtual int setValue(const std::string & val="")=0;
+    virtual int setValue(const std::string_view & val=std::string_view())=0;
     //! 
     //! @brief Zwraca typ opcji.
     //! 
@@ -155,10 +788,51 @@ public:
     //! 
     virtual const std::string & getType() const=0;
     //! 
+    //! @brief Zwraca rodzaj opcji.
+    //! 
+    //! Domyślnie opcja z pojedynczą wartością - nadpisywana przez opcje innego rodzaju (np. ict::options::counter, ict::options::vector).
+    //! 
+    //! @return Rodzaj opcji. 
+    //! 
+    virtual kind_t getKind() const {return kind_single;}
+    //! 
     //! @brief Czyści wartość opcji (i ustawia ewentualnie wartość domyślną).
     //! 
     virtual void clear()=0;
     //! 
+    //! @brief Kończy zapisywanie wartości opcji - wywoływana po przetworzeniu wszystkich argumentów (np. konwersja zebranych wartości).
+    //! 
+    //! @return Jeśli:
+    //!  @li 0 - wartość ustawiona poprawnie;
+    //!  @li -1 - wystąpił błąd.
+    //! 
+    virtual int finish(){return(0);}
+    //! 
+    //! @brief Czyści wartość opcji (patrz clear()) i ustawia źródło wartości na ict::options::source_default.
+    //! 
+    void reset(){
+        clear();
+        source=source_default;
+    }
+    //! 
+    //! @brief Zwraca źródło wartości opcji.
+    //! 
+    source_t getSource() const {return(source);}
+    //! 
+    //! @brief Wiąże opcję ze zmienną środowiskową.
+    //! 
+    //! Wartość zmiennej jest traktowana jak pojedyncze wystąpienie opcji z tą wartością (dla ict::options::counter 
+    //! - niepusta wartość oznacza jedno wystąpienie opcji).
+    //! 
+    //! @param name Nazwa zmiennej (pusta - nazwa z przedrostka kontekstu).
+    //! @return Opcja.
+    //! 
+    interface & setEnv(const std::string & name);
+    //! 
+    //! @brief Zwraca nazwę zmiennej środowiskowej (ustawioną przez setEnv()).
+    //! 
+    const std::string & getEnv() const {return(envName);}
+    //! 
     //! @brief Informuje czy wartość tego parametru jest obowiązkowa.
     //! 
     virtual bool isValueRequired()=0;
@@ -184,11 +858,17 @@ class counter : public interface{
 private:
     //! Informacja, czy ustawiona wartość jest wartością domyślną.
     bool dv=true;
+    //! Informacja, czy wartość domyślna została już przekonwertowana.
+    bool defaultReady=false;
+    //! Przekonwertowana wartość domyślna.
+    counter_t defaultCounter=0;
 public:
     //! Przechowuje typ obiektu.
     static const std::string type;
     //! Przechowuje wartość obiektu (liczbę wystąpień danej opcji).
     counter_t value=0;
+    //! Funkcja obserwująca wartość (pusta - brak).
+    observer_t<counter_t> observer;
     //! 
     //! @brief Konstruktor.
     //! 
@@ -204,28 +884,70 @@ public:
         const std::string & defaultVal="",
         const std::string & defaultDesc="",
         const locale_desc_t & localeDesc={}
+    ):counter(defaultParser(),shortOpt,longOpt,defaultVal,defaultDesc,localeDesc){}
+    //! 
+    //! @brief Konstruktor (opcja w danym kontekście parsera).
+    //! 
+    //! @param owner Kontekst parsera, w którym opcja jest rejestrowana.
+    //! @param shortOpt Lista krótkich nazw opcji (pierwsza wolna jest używana).
+    //! @param longOpt Lista długich nazw opcji (rozdzielone spacją lub przecinkiem - pierwsza wolna jest używana).
+    //! @param defaultVal Domyślna wartość (jeśli jest).
+    //! @param defaultDesc Opis opcji (domyślny).
+    //! @param localeDesc opis opcji (w róznych językach).
+    //! 
+    counter(
+        parser & owner,
+        const std::string & shortOpt="",
+        const std::string & longOpt="",
+        const std::string & defaultVal="",
+        const std::string & defaultDesc="",
+        const locale_desc_t & localeDesc={}
     ){
-        init(shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
+        init(&owner,shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
         //clear();
     }
+    //! 
+    //! @brief Konstruktor (opcja, która nie jest rejestrowana w żadnym kontekście parsera).
+    //! 
+    counter(
+        unregistered_t,
+        const std::string & shortOpt="",
+        const std::string & longOpt="",
+        const std::string & defaultVal="",
+        const std::string & defaultDesc="",
+        const locale_desc_t & localeDesc={}
+    ){
+        init(nullptr,shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
+    }
     //! Patrz ict::options::interface::setValue()
-    int setValue(const std::string & val=""){
+    int setValue(const std::string_view & val=std::string_view()){
         if (dv){
             value=0;
             dv=false;    
         }
         value++;
+        if (observer) if (observer(this,value)) return(-1);
         return(0);
     }
+    //! 
+    //! @brief Ustawia funkcję obserwującą wartość (wywoływaną przy każdym wystąpieniu opcji).
+    //! 
+    //! @param o Funkcja obserwująca (pusta - brak).
+    //! 
+    void setObserver(const observer_t<counter_t> & o){
+        observer=o;
+    }
     //! Patrz ict::options::interface::getType()
     const std::string & getType() const {return type;}
+    //! Patrz ict::options::interface::getKind()
+    kind_t getKind() const {return kind_counter;}
     //! Patrz ict::options::interface::clear()
     void clear(){
-        if (!getDefaultValue().empty()){
-            interface::setValue(getDefaultValue(),value);
-        } else {
-            value=0;
+        if (!defaultReady){
+            if (!getDefaultValue().empty()) interface::setValue(getDefaultValue(),defaultCounter);
+            defaultReady=true;
         }
+        value=defaultCounter;
         dv=true;
     }
     //! Patrz ict::options::interface::isValueRequired()
@@ -239,14 +961,22 @@ template <class Type> class single : public interface{
 private:
     //! Zawiera informację czy podanie wartości przy tej opcji jest obowiązkowe.
     bool valueRequired;
+    //! Informacja, czy wartość domyślna została już przekonwertowana.
+    bool defaultReady=false;
+    //! Przekonwertowana wartość domyślna (konwertowana raz - przy pierwszym użyciu).
+    Type defaults;
     //! Wzorzec resetujący wartość (dla podstawowych typów).
     template<class T> typename std::enable_if<std::is_fundamental<T>::value>::type clear(T & v){
         v=0;
     }
     //! Wzorzec resetujący wartość (dla innych niż podstawowe typów).
-    template<class T> typename std::enable_if<!std::is_fundamental<T>::value>::type clear(T & v){
+    template<class T> typename std::enable_if<!std::is_fundamental<T>::value&&!std::is_same<T,std::string_view>::value>::type clear(T & v){
         v.clear();
     }
+    //! Wzorzec resetujący wartość (dla widoku).
+    template<class T> typename std::enable_if<std::is_same<T,std::string_view>::value>::type clear(T & v){
+        v=std::string_view();
+    }
 public:
     //! Przechowuje typ obiektu.
     static const std::string type;
@@ -254,6 +984,8 @@ public:
     counter_t counter=0;
     //! Przechowuje wartość obiektu - ostatnią wartość podaną przy danej opcji.
     Type value;
+    //! Funkcja obserwująca wartość (pusta - brak).
+    observer_t<Type> observer;
     //! 
     //! @brief Konstruktor.
     //! 
@@ -271,27 +1003,76 @@ public:
         const std::string & defaultDesc="",
         const locale_desc_t & localeDesc={},
         bool required=true
+    ):single(defaultParser(),shortOpt,longOpt,defaultVal,defaultDesc,localeDesc,required){}
+    //! 
+    //! @brief Konstruktor (opcja w danym kontekście parsera).
+    //! 
+    //! @param owner Kontekst parsera, w którym opcja jest rejestrowana.
+    //! @param shortOpt Lista krótkich nazw opcji (pierwsza wolna jest używana).
+    //! @param longOpt Lista długich nazw opcji (rozdzielone spacją lub przecinkiem - pierwsza wolna jest używana).
+    //! @param defaultVal Domyślna wartość (jeśli jest).
+    //! @param defaultDesc Opis opcji (domyślny).
+    //! @param localeDesc opis opcji (w róznych językach).
+    //! @param required Informacja, czy podanie wartości przy tej opcji jest obowiązkowe.
+    //! 
+    single(
+        parser & owner,
+        const std::string & shortOpt="",
+        const std::string & longOpt="",
+        const std::string & defaultVal="",
+        const std::string & defaultDesc="",
+        const locale_desc_t & localeDesc={},
+        bool required=true
     ):valueRequired(required){
-        init(shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
+        init(&owner,shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
         //clear();
     }
+    //! 
+    //! @brief Konstruktor (opcja, która nie jest rejestrowana w żadnym kontekście parsera).
+    //! 
+    single(
+        unregistered_t,
+        const std::string & shortOpt="",
+        const std::string & longOpt="",
+        const std::string & defaultVal="",
+        const std::string & defaultDesc="",
+        const locale_desc_t & localeDesc={},
+        bool required=true
+    ):valueRequired(required){
+        init(nullptr,shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
+    }
     //! Patrz ict::options::interface::setValue()
-    int setValue(const std::string & val=""){
+    int setValue(const std::string_view & val=std::string_view()){
         counter++;
         if (!val.empty()) {
             if (interface::setValue(val,value)) return(-1);
         }
+        if (observer) if (observer(this,value)) return(-1);
         return(0);
     }
+    //! 
+    //! @brief Ustawia funkcję obserwującą wartość (wywoływaną przy każdym wystąpieniu opcji, po konwersji wartości).
+    //! 
+    //! @param o Funkcja obserwująca (pusta - brak).
+    //! 
+    void setObserver(const observer_t<Type> & o){
+        observer=o;
+    }
     //! Patrz ict::options::interface::getType()
     const std::string & getType() const {return type;}
+    //! Patrz ict::options::interface::getKind()
+    kind_t getKind() const {return kind_single;}
     //! Patrz ict::options::interface::clear()
     void clear(){
         counter=0;
-        clear(value);
-        if (!getDefaultValue().empty()){
-            interface::setValue(getDefaultValue(),value);
+        if (!defaultReady){
+            clear(defaults);
+            if (!getDefaultValue().empty()){
+                interface::setValue(getDefaultValue(),defaults);
+            }
+            defaultReady=true;
         }
+        value=defaults;
     }
     //! Patrz ict::options::interface::isValueRequired()
     bool isValueRequired(){
@@ -299,20 +1080,94 @@ public:
     }
 };
 template <class Type> const std::string single<Type>::type("single");
-//! Obiekt, który przechowuje zestaw wartość opcji (podawanych w kolejnych występieniach opcji).
-template <class Type> class vector : public interface{
+//! 
+//! @brief Wykonuje zadania w puli wątków (wspólnej dla wszystkich kontekstów parsera) - używane przez ict::options::vector::bulk().
+//! 
+//! Wątki puli są tworzone przy pierwszym użyciu i używane ponownie, a wątek wywołujący też wykonuje zadania.
+//! Jeśli nie można utworzyć wątku (std::system_error) albo pula jest zajęta przez inny wątek, zadania wykonują dostępne wątki
+//! (w ostateczności tylko wątek wywołujący). Funkcja wraca po wykonaniu wszystkich zadań.
+//! 
+//! @param count Liczba zadań (zadanie jest wywoływane z indeksem od 0 do count-1).
+//! @param threads Maksymalna liczba wątków (razem z wątkiem wywołującym).
+//! @param task Zadanie (nie może zgłaszać wyjątków).
+//! @param context Kontekst przekazywany do zadania.
+//! 
+void runParallel(std::size_t count,unsigned int threads,void (*task)(void * context,std::size_t index),void * context);
+//! 
+//! @brief Wykonuje zadania w puli wątków (patrz wyżej) - zadaniem jest obiekt funkcyjny wywoływany z indeksem zadania.
+//! 
+template <class Task> void runParallel(std::size_t count,unsigned int threads,Task & task){
+    runParallel(count,threads,[](void * context,std::size_t index){
+        (*static_cast<Task*>(context))(index);
+    },&task);
+}
+//! 
+//! @brief Obiekt, który przechowuje zestaw wartość opcji (podawanych w kolejnych występieniach opcji).
+//! 
+//! @tparam Type Typ wartości.
+//! @tparam Container Kontener wartości - jeśli korzysta z std::pmr::polymorphic_allocator (patrz ict::options::pmr::vector),
+//!  to używa zasobu pamięci kontekstu parsera (ict::options::parser::getMemoryResource()).
+//! 
+template <class Type,class Container=std::vector<Type>> class vector : public interface{
 private:
+    //! Opcja konwertowana przy pierwszym odczycie (ict::options::lazy) tworzy kontener przez make().
+    template <class Option> friend class lazy;
+    //! 
+    //! @brief Tworzy pusty kontener wartości.
+    //! 
+    //! @param resource Zasób pamięci (używany, jeśli kontener korzysta z std::pmr::polymorphic_allocator).
+    //! @return Kontener.
+    //! 
+    static Container make(std::pmr::memory_resource * resource){
+        if constexpr (std::is_constructible<Container,std::pmr::polymorphic_allocator<Type>>::value){
+            return(Container(std::pmr::polymorphic_allocator<Type>(resource)));
+        } else {
+            return(Container());
+        }
+    }
+    //! 
+    //! @brief Dodaje wartość na końcu kontenera (wartość jest tworzona od razu w kontenerze - z jego alokatorem).
+    //! 
+    //! @param target Kontener.
+    //! @param val Wartość w postaci tekstu.
+    //! @return Patrz ict::options::interface::setValue()
+    //! 
+    int append(Container & target,const std::string_view & val){
+        if constexpr (std::is_same<Type,bool>::value){//std::vector<bool> nie udostępnia referencji do elementu.
+            Type v{};
+            if (interface::setValue(val,v)) return(-1);
+            target.push_back(v);
+        } else if (interface::setValue(val,target.emplace_back())){
+            target.pop_back();
+            return(-1);
+        }
+        return(0);
+    }
     //! Informacja, czy ustawiona wartość jest wartością domyślną.
     bool dv=true;
     //! Zawiera informację czy podanie wartości przy tej opcji jest obowiązkowe.
     bool valueRequired;
+    //! Informacja, czy wartość domyślna została już przekonwertowana.
+    bool defaultReady=false;
+    //! Przekonwertowany zestaw wartości domyślnych (konwertowany raz - przy pierwszym użyciu).
+    Container defaults;
+    //! Minimalna liczba wartości, dla której są one konwertowane równolegle (0 - konwersja od razu w setValue()).
+    std::size_t bulkThreshold=0;
+    //! Liczba wątków konwertujących wartości (0 - liczba rdzeni).
+    unsigned int bulkThreads=0;
+    //! Wartości (w postaci tekstu) czekające na konwersję w finish().
+    std::vector<std::string_view> pending;
+    //! Informacja, czy wartości mogą być konwertowane równolegle (elementy korzystające z alokatora kontenera są tworzone w jednym wątku).
+    static constexpr bool parallel=!std::is_same<Type,bool>::value&&!std::uses_allocator<Type,typename Container::allocator_type>::value;
 public:
     //! Przechowuje typ obiektu.
     static const std::string type;
     //! Przechowuje liczbę wystąpienia danej opcji.
     counter_t counter=0;
     //! Przechowuje zestaw wartość obiektu - wszystkie wartości podane przy danej opcji.
-    std::vector<Type> value;
+    Container value;
+    //! Funkcja obserwująca wartości (pusta - brak).
+    observer_t<Type> observer;
     //! 
     //! @brief Konstruktor.
     //! 
@@ -330,37 +1185,158 @@ public:
         const std::string & defaultDesc="",
         const locale_desc_t & localeDesc={},
         bool required=true
-    ):valueRequired(required){
-        init(shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
+    ):vector(defaultParser(),shortOpt,longOpt,defaultVal,defaultDesc,localeDesc,required){}
+    //! 
+    //! @brief Konstruktor (opcja w danym kontekście parsera).
+    //! 
+    //! @param owner Kontekst parsera, w którym opcja jest rejestrowana.
+    //! @param shortOpt Lista krótkich nazw opcji (pierwsza wolna jest używana).
+    //! @param longOpt Lista długich nazw opcji (rozdzielone spacją lub przecinkiem - pierwsza wolna jest używana).
+    //! @param defaultVal Domyślna wartość (jeśli jest). Jeśli zestaw wartości, to muszą być rozdzielone znakiem nowej linii ('\n').
+    //! @param defaultDesc Opis opcji (domyślny).
+    //! @param localeDesc opis opcji (w róznych językach).
+    //! @param required Informacja, czy podanie wartości przy tej opcji jest obowiązkowe.
+    //! 
+    vector(
+        parser & owner,
+        const std::string & shortOpt="",
+        const std::string & longOpt="",
+        const std::string & defaultVal="",
+        const std::string & defaultDesc="",
+        const locale_desc_t & localeDesc={},
+        bool required=true
+    ):valueRequired(required),defaults(make(owner.getMemoryResource())),value(make(owner.getMemoryResource())){
+        init(&owner,shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
         //clear();
     }
+    //! 
+    //! @brief Konstruktor (opcja, która nie jest rejestrowana w żadnym kontekście parsera).
+    //! 
+    vector(
+        unregistered_t,
+        const std::string & shortOpt="",
+        const std::string & longOpt="",
+        const std::string & defaultVal="",
+        const std::string & defaultDesc="",
+        const locale_desc_t & localeDesc={},
+        bool required=true
+    ):valueRequired(required),defaults(make(std::pmr::get_default_resource())),value(make(std::pmr::get_default_resource())){
+        init(nullptr,shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
+    }
     //! Patrz ict::options::interface::setValue()
-    int setValue(const std::string & val=""){
+    int setValue(const std::string_view & val=std::string_view()){
         counter++;
         if (dv){
             value.clear();
             dv=false;
         }
         if (!val.empty()) {
-            Type v;
-            if (interface::setValue(val,v)) return(-1);
-            value.emplace_back(v);
+            if (bulkThreshold){
+                pending.push_back(val);
+            } else if (append(value,val)){
+                return(-1);
+            } else if (observer){
+                if (observer(this,value.back())) return(-1);
+            }
         }
         return(0);
     }
+    //! 
+    //! @brief Ustawia funkcję obserwującą wartości (wywoływaną dla każdej dodanej wartości, po jej konwersji).
+    //! 
+    //! Przy konwersji w jednym kroku (patrz bulk()) funkcja jest wywoływana w finish() - dla wszystkich wartości, w kolejności argumentów.
+    //! 
+    //! @param o Funkcja obserwująca (pusta - brak).
+    //! 
+    void setObserver(const observer_t<Type> & o){
+        observer=o;
+    }
+    //! 
+    //! @brief Włącza konwersję wartości w jednym kroku (po przetworzeniu wszystkich argumentów) - równolegle, jeśli wartości jest dużo.
+    //! 
+    //! Wartości są zapamiętywane w postaci tekstu, a konwertowane w finish() - w kilku wątkach, jeśli jest ich co najmniej threshold
+    //! (wątki pochodzą ze wspólnej puli - patrz ict::options::runParallel()).
+    //! W przypadku błędu zgłaszana jest pierwsza (w kolejności argumentów) niepoprawna wartość, a w kontenerze pozostają wartości przed nią.
+    //! 
+    //! @param threshold Minimalna liczba wartości, dla której są one konwertowane równolegle (0 - wyłącza konwersję w jednym kroku).
+    //! @param threads Liczba wątków (0 - liczba rdzeni).
+    //! 
+    void bulk(std::size_t threshold=65536,unsigned int threads=0){
+        bulkThreshold=threshold;
+        bulkThreads=threads;
+    }
+private:
+    //! 
+    //! @brief Wywołuje funkcję obserwującą dla wartości przekonwertowanych w finish().
+    //! 
+    //! @param base Indeks pierwszej wartości.
+    //! @param error Informacja, czy konwersja zakończyła się błędem.
+    //! @return Jeśli: 0 - sukces, -1 - błąd.
+    //! 
+    int observe(std::size_t base,bool error){
+        if (observer) for (std::size_t k=base;k<value.size();k++) if (observer(this,value[k])) return(-1);
+        return(error?-1:0);
+    }
+public:
+    //! Patrz ict::options::interface::finish()
+    int finish(){
+        std::size_t n=pending.size();
+        std::size_t error=n;
+        std::size_t base=value.size();
+        if (n==0) return(0);
+        if constexpr (parallel){
+            unsigned int t=bulkThreads?bulkThreads:std::thread::hardware_concurrency();
+            if ((n>=bulkThreshold)&&(t>1)){
+                std::size_t chunk;
+                std::vector<std::size_t> errors;
+                if (t>n) t=n;
+                chunk=(n+t-1)/t;
+                errors.resize(t,n);
+                value.resize(base+n);
+                auto task=[this,n,base,chunk,&errors](std::size_t i){
+                    for (std::size_t k=i*chunk;k<std::min(n,(i+1)*chunk);k++) if (interface::setValue(pending[k],value[base+k])){
+                        errors[i]=k;
+                        break;
+                    }
+                };
+                runParallel(t,t,task);
+                //Fragmenty są ułożone w kolejności argumentów - pierwszy błąd jest błędem o najniższym indeksie.
+                for (std::size_t e : errors) if (e<n){
+                    error=e;
+                    value.resize(base+e);
+                    break;
+                }
+                pending.clear();
+                return(observe(base,error<n));
+            }
+        }
+        for (std::size_t k=0;k<n;k++) if (append(value,pending[k])){
+            error=k;
+            break;
+        }
+        pending.clear();
+        return(observe(base,error<n));
+    }
     //! Patrz ict::options::interface::getType()
     const std::string & getType() const {return type;}
+    //! Patrz ict::options::interface::getKind()
+    kind_t getKind() const {return kind_vector;}
     //! Patrz ict::options::interface::clear()
     void clear(){
-        std::string val;
-        std::istringstream s(getDefaultValue());
         counter=0;
-        value.clear();
-        while (std::getline(s,val,'\n')){
-            Type v;
-            interface::setValue(val,v);
-            value.emplace_back(v);
+        if (!defaultReady){
+            std::string_view s(getDefaultValue());
+            //Podział bez kopiowania - widoki (std::string_view) wskazują na wartość domyślną.
+            for (std::size_t pos=0;pos<s.size();){
+                std::size_t end=s.find('\n',pos);
+                if (end==std::string_view::npos) end=s.size();
+                if (append(defaults,s.substr(pos,end-pos))) defaults.emplace_back();
+                pos=end+1;
+            }
+            defaultReady=true;
         }
+        value=defaults;
+        pending.clear();
         dv=true;
     }
     //! Patrz ict::options::interface::isValueRequired()
@@ -368,7 +1344,244 @@ public:
         return valueRequired;
     }
 };
-template <class Type> const std::string vector<Type>::type("vector");
+template <class Type,class Container> const std::string vector<Type,Container>::type("vector");
+//===========================================
+//! 
+//! @brief Opcja z leniwą konwersją wartości (patrz specjalizacje dla ict::options::single i ict::options::vector).
+//! 
+//! Podczas parsowania zapamiętywane są tylko widoki wskazujące na argumenty (bez konwersji), wartość jest konwertowana
+//! przy pierwszym odczycie i zapamiętywana. Widoki są ważne tak długo, jak długo istnieją argumenty przekazane do parsera.
+//! Odczyt wartości modyfikuje zapamiętaną wartość - obiekt nie może być odczytywany jednocześnie z różnych wątków.
+//! 
+template <class Option> class lazy;
+//! Obiekt, który przechowuje pojedynczą wartość opcji konwertowaną przy pierwszym odczycie.
+template <class Type> class lazy<single<Type>> : public interface{
+private:
+    //! Informacja, czy ustawiona wartość jest wartością domyślną (błąd konwersji wartości domyślnej nie jest zgłaszany).
+    bool dv=true;
+    //! Zawiera informację czy podanie wartości przy tej opcji jest obowiązkowe.
+    bool valueRequired;
+    //! Ostatnia wartość podana przy opcji (w postaci tekstu).
+    std::string_view raw;
+    //! Informacja, czy wartość została przekonwertowana.
+    mutable bool converted=false;
+    //! Przekonwertowana wartość.
+    mutable Type value{};
+public:
+    //! Przechowuje liczbę wystąpienia danej opcji.
+    counter_t counter=0;
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! Patrz ict::options::single::single()
+    //! 
+    lazy(
+        const std::string & shortOpt="",
+        const std::string & longOpt="",
+        const std::string & defaultVal="",
+        const std::string & defaultDesc="",
+        const locale_desc_t & localeDesc={},
+        bool required=true
+    ):lazy(defaultParser(),shortOpt,longOpt,defaultVal,defaultDesc,localeDesc,required){}
+    //! 
+    //! @brief Konstruktor (opcja w danym kontekście parsera).
+    //! 
+    //! Patrz ict::options::single::single()
+    //! 
+    lazy(
+        parser & owner,
+        const std::string & shortOpt="",
+        const std::string & longOpt="",
+        const std::string & defaultVal="",
+        const std::string & defaultDesc="",
+        const locale_desc_t & localeDesc={},
+        bool required=true
+    ):valueRequired(required){
+        init(&owner,shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
+    }
+    //! 
+    //! @brief Konstruktor (opcja, która nie jest rejestrowana w żadnym kontekście parsera).
+    //! 
+    lazy(
+        unregistered_t,
+        const std::string & shortOpt="",
+        const std::string & longOpt="",
+        const std::string & defaultVal="",
+        const std::string & defaultDesc="",
+        const locale_desc_t & localeDesc={},
+        bool required=true
+    ):valueRequired(required){
+        init(nullptr,shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
+    }
+    //! 
+    //! @brief Zwraca wartość opcji (konwertuje ją przy pierwszym odczycie).
+    //! 
+    //! @return Wartość opcji.
+    //! @throw std::invalid_argument Jeśli wartość jest niepoprawna.
+    //! 
+    const Type & get() const {
+        if (!converted){
+            Type v{};
+            if ((!raw.empty())&&convert(raw,v)&&!dv) throw std::invalid_argument("Invalid value: "+std::string(raw));
+            value=std::move(v);
+            converted=true;
+        }
+        return(value);
+    }
+    //! 
+    //! @brief Zwraca wartość opcji w postaci tekstu (bez konwersji).
+    //! 
+    const std::string_view & getRaw() const {return(raw);}
+    //! Patrz ict::options::interface::setValue()
+    int setValue(const std::string_view & val=std::string_view()){
+        counter++;
+        if (!val.empty()) {
+            raw=val;
+            converted=false;
+            dv=false;
+        }
+        return(0);
+    }
+    //! Patrz ict::options::interface::getType()
+    const std::string & getType() const {return single<Type>::type;}
+    //! Patrz ict::options::interface::clear()
+    void clear(){
+        counter=0;
+        raw=getDefaultValue();
+        converted=false;
+        dv=true;
+    }
+    //! Patrz ict::options::interface::isValueRequired()
+    bool isValueRequired(){
+        return valueRequired;
+    }
+};
+//! Obiekt, który przechowuje zestaw wartość opcji konwertowanych przy pierwszym odczycie.
+template <class Type,class Container> class lazy<vector<Type,Container>> : public interface{
+private:
+    //! Informacja, czy ustawiona wartość jest wartością domyślną (błąd konwersji wartości domyślnej nie jest zgłaszany).
+    bool dv=true;
+    //! Zawiera informację czy podanie wartości przy tej opcji jest obowiązkowe.
+    bool valueRequired;
+    //! Wartości podane przy opcji (w postaci tekstu).
+    std::vector<std::string_view> raw;
+    //! Wartości domyślne (w postaci tekstu - podzielone raz, przy pierwszym użyciu).
+    std::vector<std::string_view> defaults;
+    //! Informacja, czy wartości zostały przekonwertowane.
+    mutable bool converted=false;
+    //! Przekonwertowane wartości (kontener korzystający z std::pmr::polymorphic_allocator używa zasobu pamięci kontekstu parsera).
+    mutable Container value;
+public:
+    //! Przechowuje liczbę wystąpienia danej opcji.
+    counter_t counter=0;
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! Patrz ict::options::vector::vector()
+    //! 
+    lazy(
+        const std::string & shortOpt="",
+        const std::string & longOpt="",
+        const std::string & defaultVal="",
+        const std::string & defaultDesc="",
+        const locale_desc_t & localeDesc={},
+        bool required=true
+    ):lazy(defaultParser(),shortOpt,longOpt,defaultVal,defaultDesc,localeDesc,required){}
+    //! 
+    //! @brief Konstruktor (opcja w danym kontekście parsera).
+    //! 
+    //! Patrz ict::options::vector::vector()
+    //! 
+    lazy(
+        parser & owner,
+        const std::string & shortOpt="",
+        const std::string & longOpt="",
+        const std::string & defaultVal="",
+        const std::string & defaultDesc="",
+        const locale_desc_t & localeDesc={},
+        bool required=true
+    ):valueRequired(required),value(vector<Type,Container>::make(owner.getMemoryResource())){
+        init(&owner,shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
+    }
+    //! 
+    //! @brief Konstruktor (opcja, która nie jest rejestrowana w żadnym kontekście parsera).
+    //! 
+    lazy(
+        unregistered_t,
+        const std::string & shortOpt="",
+        const std::string & longOpt="",
+        const std::string & defaultVal="",
+        const std::string & defaultDesc="",
+        const locale_desc_t & localeDesc={},
+        bool required=true
+    ):valueRequired(required),value(vector<Type,Container>::make(std::pmr::get_default_resource())){
+        init(nullptr,shortOpt,longOpt,defaultVal,defaultDesc,localeDesc);
+    }
+    //! 
+    //! @brief Zwraca zestaw wartości opcji (konwertuje je przy pierwszym odczycie).
+    //! 
+    //! @return Zestaw wartości opcji.
+    //! @throw std::invalid_argument Jeśli któraś z wartości jest niepoprawna.
+    //! 
+    const Container & get() const {
+        if (!converted){
+            value.clear();
+            if constexpr (has_reserve<Container>::value) value.reserve(raw.size());
+            for (const std::string_view & r : raw){
+                Type v{};
+                if (convert(r,v)&&!dv){
+                    value.clear();
+                    throw std::invalid_argument("Invalid value: "+std::string(r));
+                }
+                value.emplace_back(std::move(v));
+            }
+            converted=true;
+        }
+        return(value);
+    }
+    //! 
+    //! @brief Zwraca zestaw wartości opcji w postaci tekstu (bez konwersji).
+    //! 
+    const std::vector<std::string_view> & getRaw() const {return(raw);}
+    //! Patrz ict::options::interface::setValue()
+    int setValue(const std::string_view & val=std::string_view()){
+        counter++;
+        if (dv){
+            raw.clear();
+            dv=false;
+        }
+        if (!val.empty()) raw.push_back(val);
+        converted=false;
+        return(0);
+    }
+    //! Patrz ict::options::interface::getType()
+    const std::string & getType() const {return vector<Type,Container>::type;}
+    //! Patrz ict::options::interface::getKind()
+    kind_t getKind() const {return kind_vector;}
+    //! Patrz ict::options::interface::clear()
+    void clear(){
+        std::string_view s(getDefaultValue());
+        counter=0;
+        if (defaults.empty()) for (std::size_t pos=0;pos<s.size();){
+            std::size_t end=s.find('\n',pos);
+            if (end==std::string_view::npos) end=s.size();
+            defaults.push_back(s.substr(pos,end-pos));
+            pos=end+1;
+        }
+        raw=defaults;
+        converted=false;
+        dv=true;
+    }
+    //! Patrz ict::options::interface::isValueRequired()
+    bool isValueRequired(){
+        return valueRequired;
+    }
+};
+//===========================================
+namespace pmr {
+//! Opcja przechowująca zestaw wartości w kontenerze korzystającym z zasobu pamięci kontekstu parsera.
+template <class Type> using vector=ict::options::vector<Type,std::pmr::vector<Type>>;
+}
 //===========================================
 } }
 //============================================
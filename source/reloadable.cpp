@@ -0,0 +1,131 @@
+//! @file
+//! @brief Reloadable module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @version 1.0
+//! @date 2021
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2021, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "reloadable.hpp"
+//===========================================
+#ifdef ENABLE_TESTING
+#include "test.hpp"
+#include "testing.hpp"
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <stdexcept>
+
+//! Zestaw opcji przeładowywany w testach.
+struct testOptions : public ict::options::parser {
+    ict::options::counter verbose{*this,"v","verbose","","Opis verbose."};
+    ict::options::single<int> port{*this,"p","port","80","Opis port."};
+    ict::options::single<std::string> name{*this,"n","name","domyslna","Opis name."};
+};
+//! Zestaw opcji, którego przetworzenie bez argumentów kończy się błędem (błędna wartość w zmiennej środowiskowej).
+struct testInvalidOptions : public ict::options::parser {
+    ict::options::single<int> port{*this,"p","port","80","Opis port."};
+    testInvalidOptions(){
+        port.setEnv("ICT_RELOADABLE_TEST_PORT");
+    }
+};
+static int testReload(ict::options::reloadable<testOptions> & options,const std::vector<std::string> & input){
+    return(options.reload([&input](testOptions & o){return(testProcess(o,input));}));
+}
+REGISTER_TEST(reloadable,tc1){
+    int out=0;
+    ict::options::reloadable<testOptions> options;
+    {
+        auto s(options.get());
+        if (s->port.value!=80) out=101;
+        if (!out) if (s->name.value!="domyslna") out=102;
+    }
+    if (!out) if (testReload(options,{"test","-vv","--port","8080","-n","alfa"})) out=103;
+    {
+        auto s(options.get());
+        if (!out) if ((s->verbose.value!=2)||(s->port.value!=8080)||(s->name.value!="alfa")) out=104;
+    }
+    if (!out) if (testReload(options,{"test","--port","x"})!=-3) out=105;//Błąd - wartości się nie zmieniają.
+    {
+        auto s(options.get());
+        if (!out) if ((s->verbose.value!=2)||(s->port.value!=8080)) out=106;
+    }
+    setenv("ICT_RELOADABLE_TEST_NAZWA","gamma",1);
+    if (!out) if (options.reload([](testOptions & o){
+        o.name.setEnv("ICT_RELOADABLE_TEST_NAZWA");
+        return(o.process(0,nullptr));
+    })) out=107;
+    unsetenv("ICT_RELOADABLE_TEST_NAZWA");
+    {
+        auto s(options.get());
+        if (!out) if ((s->verbose.value!=0)||(s->port.value!=80)||(s->name.value!="gamma")) out=108;
+    }
+    try {//Wyjątek w f - wartości się nie zmieniają.
+        options.reload([](testOptions & o)->int{
+            o.port.value=1;
+            throw std::runtime_error("test");
+        });
+        if (!out) out=109;
+    } catch (const std::runtime_error &){}
+    if (!out) if (options.get()->port.value!=80) out=110;
+    setenv("ICT_RELOADABLE_TEST_PORT","x",1);
+    try {
+        ict::options::reloadable<testInvalidOptions> invalid;
+        if (!out) out=111;
+    } catch (const std::invalid_argument &){}
+    unsetenv("ICT_RELOADABLE_TEST_PORT");
+    return(out);
+}
+REGISTER_TEST(reloadable,tc2){
+    std::atomic<int> out(0);
+    std::atomic<bool> done(false);
+    ict::options::reloadable<testOptions> options;
+    std::vector<std::thread> readers;
+    for (int t=0;t<4;t++) readers.emplace_back([&](){
+        while ((!done)&&(!out)){
+            auto s(options.get());
+            //Wartości w jednej kopii są zawsze spójne.
+            if (std::to_string(s->port.value)!=s->name.value){
+                if (s->port.value!=80) out=101;
+            }
+        }
+    });
+    for (int k=1;(k<200)&&(!out);k++){
+        std::string n(std::to_string(k));
+        if (testReload(options,{"test","-p",n,"-n",n})) out=102;
+    }
+    done=true;
+    for (auto & t : readers) t.join();
+    if (!out) if (options.get()->port.value!=199) out=103;
+    return(out);
+}
+#endif
+//===========================================
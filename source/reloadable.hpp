@@ -0,0 +1,172 @@
+//! @file
+//! @brief Reloadable module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @version 1.0
+//! @date 2021
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2021, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _ICT_RELOADABLE_HEADER
+#define _ICT_RELOADABLE_HEADER
+//============================================
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "options.hpp"
+//============================================
+namespace ict { namespace  options { 
+//===========================================
+//! 
+//! @brief Zestaw opcji przeładowywany w trakcie działania programu (bez blokowania odczytów).
+//! 
+//! Nowe wartości są parsowane do nowej kopii zestawu opcji, która jest następnie publikowana atomowo (jak w RCU).
+//! Odczyt odbywa się przez migawkę (ict::options::reloadable::snapshot) - bez blokad i oczekiwania. Poprzednia kopia
+//! jest usuwana po zakończeniu wszystkich migawek, które mogły ją widzieć (na to czeka reload()).
+//! 
+//! @tparam Options Zestaw opcji - klasa dziedzicząca po ict::options::parser (z konstruktorem domyślnym), 
+//!  której opcje są rejestrowane w niej samej.
+//! 
+template <class Options> class reloadable {
+private:
+    //! Aktualna kopia zestawu opcji.
+    std::atomic<Options*> current;
+    //! Aktualna faza (parzystość) czytelników.
+    std::atomic<unsigned int> phase{0};
+    //! Liczba aktywnych migawek w każdej z faz.
+    mutable std::atomic<std::size_t> readers[2]={{0},{0}};
+    //! Serializuje przeładowania.
+    std::mutex writer;
+    //! 
+    //! @brief Czeka, aż zakończą się wszystkie migawki, które mogły widzieć poprzednią kopię (dwie zmiany fazy).
+    //! 
+    void synchronize(){
+        for (int k=0;k<2;k++){
+            unsigned int p=phase.fetch_add(1);
+            while (readers[p&1].load()) std::this_thread::yield();
+        }
+    }
+public:
+    //! Migawka zestawu opcji - kopia nie zmienia się, dopóki istnieje migawka.
+    class snapshot {
+    private:
+        //! Liczba aktywnych migawek w fazie, w której utworzono migawkę.
+        std::atomic<std::size_t> * counter=nullptr;
+        //! Kopia zestawu opcji.
+        const Options * ptr=nullptr;
+    public:
+        //! 
+        //! @brief Konstruktor.
+        //! 
+        //! @param owner Przeładowywany zestaw opcji.
+        //! 
+        explicit snapshot(const reloadable & owner){
+            counter=&owner.readers[owner.phase.load()&1];
+            counter->fetch_add(1);
+            ptr=owner.current.load();
+        }
+        snapshot(const snapshot &)=delete;
+        snapshot & operator=(const snapshot &)=delete;
+        snapshot(snapshot && other):counter(other.counter),ptr(other.ptr){
+            other.counter=nullptr;
+            other.ptr=nullptr;
+        }
+        //! Destruktor - kończy migawkę.
+        ~snapshot(){
+            if (counter) counter->fetch_sub(1);
+        }
+        //! Dostęp do zestawu opcji.
+        const Options & operator*() const {return(*ptr);}
+        //! Dostęp do zestawu opcji.
+        const Options * operator->() const {return(ptr);}
+    };
+    //! 
+    //! @brief Konstruktor - tworzy zestaw opcji z wartościami domyślnymi.
+    //! 
+    //! @throw std::invalid_argument Gdy przetworzenie opcji bez argumentów (process(0,nullptr)) zakończy się błędem.
+    //! 
+    reloadable(){
+        std::unique_ptr<Options> first(new Options);
+        if (first->process(0,nullptr)) throw std::invalid_argument("ict::options::reloadable - invalid default values");
+        current.store(first.release());
+    }
+    reloadable(const reloadable &)=delete;
+    reloadable & operator=(const reloadable &)=delete;
+    //! Destruktor (nie może istnieć żadna migawka).
+    ~reloadable(){
+        delete current.load();
+    }
+    //! 
+    //! @brief Tworzy migawkę aktualnego zestawu opcji (bez blokad i oczekiwania).
+    //! 
+    //! @return Migawka.
+    //! 
+    snapshot get() const {
+        return(snapshot(*this));
+    }
+    //! 
+    //! @brief Przeładowuje zestaw opcji - tworzy nową kopię, przygotowuje ją funkcją f i publikuje (jeśli f zwróci 0).
+    //! 
+    //! Czeka na zakończenie migawek poprzedniej kopii - wątek wywołujący nie może w tym czasie posiadać migawki.
+    //! 
+    //! @param f Funkcja wywoływana z parametrem (Options & options) i zwracająca int (np. ustawia plik konfiguracyjny i wywołuje process()).
+    //! @return Wartość zwrócona przez f (0 - nowa kopia została opublikowana, w przeciwnym razie wartości się nie zmieniają).
+    //!  Jeśli f zgłosi wyjątek, nowa kopia jest usuwana, a wyjątek przekazywany dalej.
+    //! 
+    template <class Function> int reload(Function && f){
+        std::lock_guard<std::mutex> lock(writer);
+        std::unique_ptr<Options> next(new Options);
+        Options * prev;
+        int out=f(*next);
+        if (out) return(out);
+        prev=current.exchange(next.release());
+        synchronize();
+        delete prev;
+        return(0);
+    }
+    //! 
+    //! @brief Przeładowuje zestaw opcji z podanych argumentów.
+    //! 
+    //! Widoki w wartościach opcji (np. std::string_view) wskazują na argumenty - muszą one istnieć, dopóki kopia jest używana.
+    //! 
+    //! @param argc Liczba argumentów.
+    //! @param argv Argumenty.
+    //! @return Patrz ict::options::process() (0 - nowa kopia została opublikowana).
+    //! 
+    int reload(int argc,char *const argv[]){
+        return(reload([argc,argv](Options & options){return(options.process(argc,argv));}));
+    }
+};
+//===========================================
+} }
+//============================================
+#endif
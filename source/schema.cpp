@@ -0,0 +1,155 @@
+//! @file
+//! @brief Schema module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @version 1.0
+//! @date 2021
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2021, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "schema.hpp"
+//===========================================
+#ifdef ENABLE_TESTING
+#include "test.hpp"
+#include "testing.hpp"
+#include <cstdlib>
+
+inline constexpr auto schema1=ict::options::schema(
+    ict::options::def<ict::options::counter>('v',"verbose","","Opis verbose (licznik)."),
+    ict::options::def<ict::options::single<int>>('t',"timeout","100","Opis timeout (int domyślnie ustawiony na 100)."),
+    ict::options::def<ict::options::vector<double>>('x',"value","1.5\n2.5","Opis value (tablica double domyślnie ustawiona na 1.5 i 2.5)."),
+    ict::options::def<ict::options::single<std::string>>(0,"name","","Opis name (string z nieobowiązkowym parametrem).",false)
+);
+static_assert(ict::options::compiled<schema1>::indexOf("verbose")==0);
+static_assert(ict::options::compiled<schema1>::indexOf("timeout")==1);
+static_assert(ict::options::compiled<schema1>::indexOf("value")==2);
+static_assert(ict::options::compiled<schema1>::indexOf("name")==3);
+static_assert(ict::options::compiled<schema1>::indexOf("nieznana")==4);
+inline constexpr auto schema2=ict::options::schema(
+    ict::options::def<ict::options::counter>('A',"opcja-a","","Opis opcja-a."),
+    ict::options::def<ict::options::counter>('B',"opcja-b","","Opis opcja-b."),
+    ict::options::def<ict::options::counter>('C',"opcja-c","","Opis opcja-c."),
+    ict::options::def<ict::options::counter>('D',"opcja-d","","Opis opcja-d."),
+    ict::options::def<ict::options::counter>('E',"opcja-e","","Opis opcja-e."),
+    ict::options::def<ict::options::counter>('F',"opcja-f","","Opis opcja-f."),
+    ict::options::def<ict::options::counter>('G',"opcja-g","","Opis opcja-g."),
+    ict::options::def<ict::options::counter>('H',"opcja-h","","Opis opcja-h."),
+    ict::options::def<ict::options::counter>('I',"opcja-i","","Opis opcja-i."),
+    ict::options::def<ict::options::counter>('J',"opcja-j","","Opis opcja-j."),
+    ict::options::def<ict::options::counter>('K',"opcja-k","","Opis opcja-k."),
+    ict::options::def<ict::options::counter>('L',"opcja-l","","Opis opcja-l."),
+    ict::options::def<ict::options::counter>('M',"opcja-m","","Opis opcja-m."),
+    ict::options::def<ict::options::counter>('N',"opcja-n","","Opis opcja-n."),
+    ict::options::def<ict::options::counter>('O',"opcja-o","","Opis opcja-o."),
+    ict::options::def<ict::options::counter>('P',"opcja-p","","Opis opcja-p."),
+    ict::options::def<ict::options::counter>('Q',"opcja-q","","Opis opcja-q."),
+    ict::options::def<ict::options::counter>('R',"opcja-r","","Opis opcja-r."),
+    ict::options::def<ict::options::counter>('S',"opcja-s","","Opis opcja-s."),
+    ict::options::def<ict::options::counter>('T',"opcja-t","","Opis opcja-t."),
+    ict::options::def<ict::options::counter>('U',"opcja-u","","Opis opcja-u."),
+    ict::options::def<ict::options::counter>('V',"opcja-v","","Opis opcja-v."),
+    ict::options::def<ict::options::counter>('W',"opcja-w","","Opis opcja-w."),
+    ict::options::def<ict::options::counter>('X',"opcja-x","","Opis opcja-x."),
+    ict::options::def<ict::options::counter>('Y',"opcja-y","","Opis opcja-y."),
+    ict::options::def<ict::options::counter>('Z',"opcja-z","","Opis opcja-z.")
+);
+template <std::size_t... I> constexpr bool allFound(std::index_sequence<I...>){
+    return(((ict::options::compiled<schema2>::indexOf(schema2.specs[I].longName)==I)&&...));
+}
+static_assert(allFound(std::make_index_sequence<schema2.size>()));
+ict::options::compiled<schema1> options1;
+ict::options::compiled<schema2> options2;
+
+REGISTER_TEST(schema,tc1){
+    int out=0;
+    out=testProcess(options1,{"test"});
+    if (!out) if (options1.get<0>().value!=0) out=101;
+    if (!out) if (options1.get<1>().counter!=0) out=102;
+    if (!out) if (options1.get<1>().value!=100) out=103;
+    if (!out) if (options1.get<2>().value.size()!=2) out=104;
+    if (!out) if (options1.get<2>().value.at(0)!=1.5) out=105;
+    if (!out) if (options1.get<2>().value.at(1)!=2.5) out=106;
+    if (!out) if (options1.get<3>().counter!=0) out=107;
+    if (!out) if (options1.noOptions().size()!=0) out=108;
+    return(out);
+}
+REGISTER_TEST(schema,tc2){
+    int out=0;
+    out=testProcess(options1,{"test","-vv","--timeout","7","-x3.5","plik","--val=4.5","--name","--verbose"});
+    if (!out) if (options1.get<0>().value!=3) out=101;
+    if (!out) if (options1.get<1>().counter!=1) out=102;
+    if (!out) if (options1.get<1>().value!=7) out=103;
+    if (!out) if (options1.get<2>().value.size()!=2) out=104;
+    if (!out) if (options1.get<2>().value.at(0)!=3.5) out=105;
+    if (!out) if (options1.get<2>().value.at(1)!=4.5) out=106;
+    if (!out) if (options1.get<3>().counter!=1) out=107;
+    if (!out) if (options1.get<3>().value!="") out=108;
+    if (!out) if (options1.noOptions().size()!=1) out=109;
+    if (!out) if (options1.noOptions().at(0)!="plik") out=110;
+    return(out);
+}
+REGISTER_TEST(schema,tc3){
+    int out=0;
+    if (testProcess(options1,{"test","--nieznana"})!=-1) out=101;
+    if (!out) if (testProcess(options1,{"test","-t"})!=-2) out=102;
+    if (!out) if (testProcess(options1,{"test","--verbose=1"})!=-1) out=103;
+    if (!out) if (testProcess({"test","--timeout","1"})!=-1) out=104;//Opcje ze schematu nie są rejestrowane w kontekście domyślnym.
+    return(out);
+}
+REGISTER_TEST(schema,tc4){
+    int out=0;
+    out=testProcess(options2,{"test","-AZ","--opcja-q","--opcja-z","--opcja-a"});
+    if (!out) if (options2.get<0>().value!=2) out=101;
+    if (!out) if (options2.get<16>().value!=1) out=102;
+    if (!out) if (options2.get<25>().value!=2) out=103;
+    if (!out) if (options2.get<1>().value!=0) out=104;
+    if (!out) if (testProcess(options2,{"test","--opcja"})!=-1) out=105;//Niejednoznaczny skrót.
+    return(out);
+}
+REGISTER_TEST(schema,tc5){
+    int out=0;
+    ict::options::compiled<schema1> options;
+    options.context().setEnvPrefix("ICT_SCHEMA_TEST_");
+    setenv("ICT_SCHEMA_TEST_TIMEOUT","42",1);
+    setenv("ICT_SCHEMA_TEST_NAZWA","alfa",1);
+    if (testProcess(options,{"test"})) out=101;
+    if (!out) if ((options.get<1>().value!=42)||(options.get<1>().getSource()!=ict::options::source_env)) out=102;
+    if (!out) if (options.get<3>().value!="") out=103;
+    options.get<3>().setEnv("ICT_SCHEMA_TEST_NAZWA");//Zmiana po pierwszym wywołaniu process().
+    if (!out) if (testProcess(options,{"test","-t","7"})) out=104;
+    if (!out) if ((options.get<1>().value!=7)||(options.get<3>().value!="alfa")) out=105;
+    unsetenv("ICT_SCHEMA_TEST_TIMEOUT");
+    unsetenv("ICT_SCHEMA_TEST_NAZWA");
+    if (!out) if (testProcess(options,{"test"})) out=106;
+    if (!out) if ((options.get<1>().value!=100)||(options.get<3>().value!="")) out=107;
+    return(out);
+}
+#endif
+//===========================================
@@ -0,0 +1,373 @@
+//! @file
+//! @brief Schema module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @version 1.0
+//! @date 2021
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2021, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _ICT_SCHEMA_HEADER
+#define _ICT_SCHEMA_HEADER
+//============================================
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <string_view>
+#include <type_traits>
+#include "options.hpp"
+//============================================
+namespace ict { namespace  options { 
+//===========================================
+//! Informuje, czy opcja danego typu przyjmuje argument.
+template <class Option> struct has_argument : public std::true_type {};
+template <> struct has_argument<counter> : public std::false_type {};
+//! Definicja opcji w schemacie (bez typu opcji).
+struct spec_t {
+    //! Krótka nazwa opcji (0 - brak).
+    char shortName=0;
+    //! Długa nazwa opcji (pusta - brak).
+    std::string_view longName;
+    //! Domyślna wartość (jeśli jest).
+    std::string_view defaultValue;
+    //! Opis opcji (domyślny).
+    std::string_view description;
+    //! Rodzaj argumentu opcji.
+    argument_t argument=argument_none;
+};
+//! Definicja opcji danego typu w schemacie.
+template <class Option> struct def : public spec_t {
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param shortOpt Krótka nazwa opcji (0 - brak).
+    //! @param longOpt Długa nazwa opcji (pusta - brak).
+    //! @param defaultVal Domyślna wartość (jeśli jest).
+    //! @param defaultDesc Opis opcji (domyślny).
+    //! @param required Informacja, czy podanie wartości przy tej opcji jest obowiązkowe.
+    //! 
+    constexpr def(
+        char shortOpt,
+        std::string_view longOpt,
+        std::string_view defaultVal="",
+        std::string_view defaultDesc="",
+        bool required=true
+    ):spec_t{
+        shortOpt,longOpt,defaultVal,defaultDesc,
+        has_argument<Option>::value?(required?argument_required:argument_optional):argument_none
+    }{}
+};
+//! 
+//! @brief Tworzy opcję na podstawie definicji ze schematu (opcja nie jest rejestrowana).
+//! 
+//! @param s Definicja opcji.
+//! @return Opcja.
+//! 
+template <class Option> Option schemaOption(const spec_t & s){
+    std::string shortOpt(s.shortName?1:0,s.shortName);
+    if constexpr (has_argument<Option>::value){
+        return(Option(unregistered,shortOpt,std::string(s.longName),std::string(s.defaultValue),std::string(s.description),{},s.argument==argument_required));
+    } else {
+        return(Option(unregistered,shortOpt,std::string(s.longName),std::string(s.defaultValue),std::string(s.description),{}));
+    }
+}
+//! Opcja o danym indeksie w schemacie (klasa bazowa ict::options::schema_storage_t).
+template <std::size_t I,class Option> struct schema_slot_t {
+    //! Opcja.
+    Option option;
+};
+//! 
+//! @brief Opcje schematu.
+//! 
+//! Każda opcja jest osobną, bezpośrednią klasą bazową (a nie rekurencyjnie, jak w std::tuple), więc głębokość instancjonowania szablonów nie zależy od liczby opcji.
+//! 
+template <class Indices,class... Options> struct schema_storage_t;
+template <std::size_t... I,class... Options> struct schema_storage_t<std::index_sequence<I...>,Options...> : public schema_slot_t<I,Options>... {
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param specs Definicje opcji.
+    //! 
+    explicit schema_storage_t(const std::array<spec_t,sizeof...(Options)> & specs):
+        schema_slot_t<I,Options>{schemaOption<Options>(specs[I])}...{}
+    schema_storage_t(const schema_storage_t &)=delete;
+    schema_storage_t & operator=(const schema_storage_t &)=delete;
+    //! Zwraca wskaźniki do opcji (w kolejności ze schematu).
+    std::array<interface*,sizeof...(Options)> pointers(){
+        return(std::array<interface*,sizeof...(Options)>{{&static_cast<schema_slot_t<I,Options>&>(*this).option...}});
+    }
+};
+//! Zwraca opcję o danym indeksie (typ opcji jest wyznaczany z klasy bazowej).
+template <std::size_t I,class Option> Option & schemaGet(schema_slot_t<I,Option> & s){return(s.option);}
+//! Zwraca opcję o danym indeksie (typ opcji jest wyznaczany z klasy bazowej).
+template <std::size_t I,class Option> const Option & schemaGet(const schema_slot_t<I,Option> & s){return(s.option);}
+//! Schemat opcji - lista definicji opcji wraz z ich typami.
+template <class... Options> struct schema_t {
+    //! Opcje schematu.
+    typedef schema_storage_t<std::index_sequence_for<Options...>,Options...> storage_t;
+    //! Liczba opcji.
+    static constexpr std::size_t size=sizeof...(Options);
+    //! Definicje opcji.
+    std::array<spec_t,sizeof...(Options)> specs;
+};
+//! 
+//! @brief Tworzy schemat opcji (w czasie kompilacji).
+//! 
+//! @param defs Definicje opcji.
+//! @return Schemat opcji.
+//! 
+template <class... Options> constexpr schema_t<Options...> schema(const def<Options> & ... defs){
+    return(schema_t<Options...>{{{defs...}}});
+}
+//! 
+//! @brief Funkcja haszująca dla nazw opcji (FNV-1a z ziarnem).
+//! 
+//! @param name Nazwa opcji.
+//! @param seed Ziarno.
+//! @return Wartość funkcji haszującej.
+//! 
+constexpr std::uint32_t schemaHash(const std::string_view & name,std::uint32_t seed){
+    std::uint32_t h=2166136261u^(seed*16777619u);
+    for (const char & c : name){
+        h^=(unsigned char)c;
+        h*=16777619u;
+    }
+    return(h);
+}
+//! 
+//! @brief Zwraca liczbę pozycji w tablicy haszującej (potęga dwójki, co najmniej dwa razy więcej niż opcji).
+//! 
+constexpr std::size_t schemaSlots(std::size_t n){
+    std::size_t m=1;
+    while (m<(2*n)) m<<=1;
+    return(m);
+}
+//! Tablice wyszukiwania opcji wygenerowane w czasie kompilacji.
+template <std::size_t N> struct schema_tables_t {
+    //! Liczba koszyków (pierwszy poziom haszowania).
+    static constexpr std::size_t buckets=N?N:1;
+    //! Liczba pozycji w tablicy haszującej (drugi poziom haszowania).
+    static constexpr std::size_t slots=schemaSlots(N);
+    //! Informacja, czy tablice są poprawne (brak powtórzonych nazw i znaleziona doskonała funkcja haszująca).
+    bool valid=true;
+    //! Indeksy opcji (+1) dla krótkich nazw.
+    std::array<std::uint16_t,256> shortIndex{};
+    //! Ziarna funkcji haszującej dla każdego z koszyków.
+    std::array<std::uint32_t,buckets> displacement{};
+    //! Indeksy opcji (+1) dla pozycji tablicy haszującej.
+    std::array<std::uint16_t,slots> slotIndex{};
+};
+//! 
+//! @brief Buduje tablice wyszukiwania opcji (w czasie kompilacji).
+//! 
+//! Długie nazwy są umieszczane w tablicy haszującej bez kolizji (doskonała funkcja haszująca typu "hash and displace"):
+//! nazwa jest przypisywana do koszyka, a dla każdego koszyka wyszukiwane jest ziarno, przy którym jego nazwy trafiają na wolne pozycje.
+//! Listy nazw w koszykach są budowane raz, a powtórzone nazwy są wykrywane w obrębie koszyka - koszt jest liniowy względem liczby opcji.
+//! 
+//! @param specs Definicje opcji.
+//! @return Tablice wyszukiwania opcji.
+//! 
+template <std::size_t N> constexpr schema_tables_t<N> schemaTables(const std::array<spec_t,N> & specs){
+    typedef schema_tables_t<N> tables_t;
+    tables_t t{};
+    std::array<std::size_t,tables_t::buckets> bucket{};
+    std::array<std::size_t,tables_t::buckets+1> first{};//Początki list opcji w koszykach (w members).
+    std::array<std::size_t,tables_t::buckets> next{};
+    std::array<std::size_t,tables_t::buckets> members{};//Indeksy opcji uporządkowane według koszyków.
+    std::array<std::size_t,tables_t::buckets+1> sizes{};
+    std::array<std::size_t,tables_t::buckets> order{};
+    std::array<std::size_t,tables_t::buckets> placed{};
+    std::array<bool,tables_t::slots> used{};
+    static_assert(N<0xffff,"ict::options::schema - too many options");
+    for (std::size_t i=0;i<N;i++) if (specs[i].shortName){
+        unsigned char c=specs[i].shortName;
+        if (t.shortIndex[c]) t.valid=false;//Powtórzona krótka nazwa.
+        t.shortIndex[c]=i+1;
+    }
+    for (std::size_t i=0;i<N;i++) if (!specs[i].longName.empty()){
+        bucket[i]=schemaHash(specs[i].longName,0)%tables_t::buckets;
+        first[bucket[i]+1]++;
+    }
+    for (std::size_t b=0;b<tables_t::buckets;b++){
+        first[b+1]+=first[b];
+        next[b]=first[b];
+    }
+    for (std::size_t i=0;i<N;i++) if (!specs[i].longName.empty()) members[next[bucket[i]]++]=i;
+    for (std::size_t b=0;b<tables_t::buckets;b++){//Powtórzona długa nazwa trafia do tego samego koszyka.
+        for (std::size_t i=first[b];i<first[b+1];i++) for (std::size_t j=first[b];j<i;j++){
+            if (specs[members[i]].longName==specs[members[j]].longName) t.valid=false;
+        }
+    }
+    if (!t.valid) return(t);
+    for (std::size_t b=0;b<tables_t::buckets;b++) sizes[first[b+1]-first[b]]++;
+    for (std::size_t k=tables_t::buckets;k>0;k--) sizes[k-1]+=sizes[k];
+    for (std::size_t b=0;b<tables_t::buckets;b++){//Największe koszyki są rozmieszczane jako pierwsze (sortowanie przez zliczanie).
+        std::size_t k=first[b+1]-first[b];
+        order[(k<tables_t::buckets)?sizes[k+1]:0]=b;
+        if (k<tables_t::buckets) sizes[k+1]++;
+    }
+    for (std::size_t a=0;(a<tables_t::buckets)&&(first[order[a]+1]>first[order[a]]);a++){
+        std::size_t b=order[a];
+        bool found=false;
+        for (std::uint32_t d=1;(d<(1u<<16))&&(!found);d++){
+            std::size_t n=0;
+            found=true;
+            for (std::size_t i=first[b];(i<first[b+1])&&found;i++){
+                std::size_t s=schemaHash(specs[members[i]].longName,d)&(tables_t::slots-1);
+                if (used[s]) found=false;
+                for (std::size_t k=0;(k<n)&&found;k++) if (placed[k]==s) found=false;
+                placed[n++]=s;
+            }
+            if (found){
+                t.displacement[b]=d;
+                for (std::size_t i=first[b];i<first[b+1];i++){
+                    used[placed[i-first[b]]]=true;
+                    t.slotIndex[placed[i-first[b]]]=members[i]+1;
+                }
+            }
+        }
+        if (!found){
+            t.valid=false;
+            return(t);
+        }
+    }
+    return(t);
+}
+//! 
+//! @brief Obiekt przechowujący opcje zdefiniowane w schemacie (w czasie kompilacji).
+//! 
+//! Tablice wyszukiwania krótkich i długich nazw (doskonała funkcja haszująca) są generowane w czasie kompilacji,
+//! a opcje nie są rejestrowane w żadnym rejestrze. Semantyka opcji (counter, single<T>, vector<T>) jest taka sama.
+//! 
+//! @tparam Schema Schemat opcji (patrz ict::options::schema()).
+//! 
+template <const auto & Schema> class compiled : public lookup {
+public:
+    //! Typ schematu.
+    typedef std::decay_t<decltype(Schema)> schema_type;
+    //! Typ opcji o danym indeksie (w kolejności ze schematu).
+    template <std::size_t I> using option_t=std::remove_reference_t<decltype(schemaGet<I>(std::declval<typename schema_type::storage_t &>()))>;
+    //! Liczba opcji.
+    static constexpr std::size_t size=schema_type::size;
+    //! Tablice wyszukiwania opcji.
+    static constexpr schema_tables_t<size> tables=schemaTables(Schema.specs);
+    static_assert(tables.valid,"ict::options::compiled - duplicate option names in schema (or perfect hash not found)");
+    //! 
+    //! @brief Zwraca indeks opcji o danej długiej nazwie (może być użyta w czasie kompilacji).
+    //! 
+    //! @param name Długa nazwa opcji.
+    //! @return Indeks opcji lub size, jeśli nie znaleziono.
+    //! 
+    static constexpr std::size_t indexOf(const std::string_view & name){
+        if (name.empty()) return(size);
+        {
+            std::size_t b=schemaHash(name,0)%schema_tables_t<size>::buckets;
+            std::size_t i=tables.slotIndex[schemaHash(name,tables.displacement[b])&(schema_tables_t<size>::slots-1)];
+            if (i&&(Schema.specs[i-1].longName==name)) return(i-1);
+        }
+        return(size);
+    }
+private:
+    //! Opcje.
+    typename schema_type::storage_t options;
+    //! Wskaźniki do opcji (w kolejności ze schematu).
+    std::array<interface*,size> pointers;
+    //! Kontekst parsera (lista argumentów, które nie są opcjami).
+    parser ctx;
+public:
+    //! Konstruktor.
+    compiled():options(Schema.specs),pointers(options.pointers()){}
+    compiled(const compiled &)=delete;
+    compiled & operator=(const compiled &)=delete;
+    //! Patrz ict::options::lookup::findShort()
+    entry_t findShort(char c) const {
+        std::size_t i=tables.shortIndex[(unsigned char)c];
+        if (!i) return(entry_t());
+        return(entry_t{pointers[i-1],Schema.specs[i-1].argument});
+    }
+    //! Patrz ict::options::lookup::findLong()
+    entry_t findLong(const std::string_view & name) const {
+        std::size_t i=indexOf(name);
+        if (i<size) return(entry_t{pointers[i],Schema.specs[i].argument});
+        {//Jednoznaczny skrót nazwy.
+            entry_t out;
+            for (std::size_t k=0;k<size;k++) if ((!name.empty())&&(Schema.specs[k].longName.substr(0,name.size())==name)){
+                if (out.ptr) return(entry_t());
+                out=entry_t{pointers[k],Schema.specs[k].argument};
+            }
+            return(out);
+        }
+    }
+    //! Patrz ict::options::lookup::findExact()
+    entry_t findExact(const std::string_view & name) const {
+        std::size_t i=indexOf(name);
+        if (i<size) return(entry_t{pointers[i],Schema.specs[i].argument});
+        return(entry_t());
+    }
+    //! Patrz ict::options::lookup::optionCount()
+    std::size_t optionCount() const {return(size);}
+    //! Patrz ict::options::lookup::optionAt()
+    interface * optionAt(std::size_t k) const {return(pointers[k]);}
+    //! 
+    //! @brief Procesuje parametry funkcji main.
+    //! 
+    //! Patrz ict::options::process()
+    //! 
+    int process(int argc,char *const argv[]){
+        for (interface * ptr : pointers) ptr->reset();
+        int out=ctx.process(*this,argc,argv);
+        if (!out) for (interface * ptr : pointers) if (ptr->finish()) if (!out) out=-3;
+        if ((!out)&&ctx.getEndCallback()) out=ctx.getEndCallback()(nullptr,std::string_view());
+        return(out);
+    }
+    //! 
+    //! @brief Udostępnia listę argumentów z funkcji main, które nie są opcjami.
+    //! 
+    const notOption_t & noOptions() const {return(ctx.noOptions());}
+    //! 
+    //! @brief Udostępnia listę argumentów z funkcji main, które nie są opcjami, w postaci widoków (bez kopiowania).
+    //! 
+    const notOptionView_t & noOptionsView() const {return(ctx.noOptionsView());}
+    //! 
+    //! @brief Udostępnia kontekst parsera używany przez ten obiekt.
+    //! 
+    parser & context(){return(ctx);}
+    //! 
+    //! @brief Udostępnia opcję o danym indeksie (w kolejności ze schematu).
+    //! 
+    template <std::size_t I> option_t<I> & get(){return(schemaGet<I>(options));}
+    //! 
+    //! @brief Udostępnia opcję o danym indeksie (w kolejności ze schematu).
+    //! 
+    template <std::size_t I> const option_t<I> & get() const {return(schemaGet<I>(options));}
+};
+//===========================================
+} }
+//============================================
+#endif
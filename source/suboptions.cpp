@@ -36,48 +36,62 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //============================================
 #include "suboptions.hpp"
 #include <vector>
-#include <stdlib.h>
 //============================================
 namespace ict { namespace  options { 
 //============================================
 #include "tokenizer.cpp"
 //============================================
-typedef std::vector<char*> suboptions_vector_t;
-int subprocess(const std::string & input,const std::string & tokens,suboptions_t & output){
-    tokens_t tk;
-    suboptions_vector_t sv;
-    tokenizer(tokens,tk);
-    for (std::string & t : tk) {
-        sv.emplace_back(&t[0]);
-    }
-    sv.emplace_back(nullptr);
-    {
-        std::string i(input);
-        char *subopts;
-        char *value;
-        subopts=&i[0];
-        while (*subopts!='\0') {
-            int k=getsubopt(&subopts,&sv[0],&value);
-            if (k<tk.size()){
-                output[tk.at(k)]=value?value:"";
+subtokens::subtokens(const std::string & tokens){
+    tokenizer(tokens,names);
+    //Klucze wskazują na nazwy - tablica jest budowana po utworzeniu wszystkich nazw.
+    index.reserve(names.size());
+    for (std::size_t k=0;k<names.size();k++) index.emplace(names[k],k);
+}
+//! 
+//! @brief Przetwarza subopcje.
+//! 
+//! Patrz ict::options::subprocess()
+//! 
+template <class Map> static int subprocessMap(const std::string_view & input,const subtokens & tokens,Map & output){
+    return(subscan(input,[&tokens,&output](const std::string_view & name,const std::string_view & value){
+        int k=tokens.find(name);
+        if (k>=0){
+            const std::string & n(tokens.name(k));
+            if constexpr (std::is_same<typename Map::key_type,std::string>::value){
+                output[n].assign(value.data(),value.size());
+            } else {
+                output[typename Map::key_type(n.data(),n.size(),output.get_allocator())].assign(value.data(),value.size());
             }
         }
-    }
-    return(0);
+        return(0);
+    }));
+}
+int subprocess(const std::string_view & input,const subtokens & tokens,suboptions_t & output){
+    return(subprocessMap(input,tokens,output));
+}
+int subprocess(const std::string_view & input,const subtokens & tokens,pmr::suboptions_t & output){
+    return(subprocessMap(input,tokens,output));
+}
+int subprocess(const std::string_view & input,const subtokens & tokens,flat_suboptions_t & output){
+    return(subscan(output.store(input),[&tokens,&output](const std::string_view & name,const std::string_view & value){
+        int k=tokens.find(name);
+        if (k>=0) output.set(tokens.name(k),value);
+        return(0);
+    }));
+}
+int subprocess(const std::string & input,const std::string & tokens,suboptions_t & output){
+    return(subprocessMap(input,subtokens(tokens),output));
+}
+int subprocess(const std::string & input,const std::string & tokens,pmr::suboptions_t & output){
+    return(subprocessMap(input,subtokens(tokens),output));
 }
 //===========================================
 } }
 //===========================================
 #ifdef ENABLE_TESTING
 #include "test.hpp"
+#include "testing.hpp"
 
-static int testProcess(const std::vector<std::string> & input){
-    std::vector<std::string> a(input);
-    std::vector<char*> v;
-    for (auto & s : a) v.push_back(&s[0]);
-    v.push_back(nullptr);
-    return(ict::options::process(a.size(),&v[0]));
-}
 std::string opcja1("ala,ma,kota");
 ict::options::single<ict::options::suboptions<opcja1>> subparam1("moplf","","ala=nic","Opis subparam1");
 ict::options::vector<ict::options::suboptions<opcja1>> subparam2("hjli","","ala=nic\nma=koty","Opis subparam2");
@@ -137,5 +151,125 @@ REGISTER_TEST(suboptions,tc5){
     if (!out) if (subparam2.value.at(1).at("ma")!="koty") out=110;
     return(out);
 }
+REGISTER_TEST(suboptions,tc6){
+    int out=0;
+    std::pmr::monotonic_buffer_resource arena;
+    ict::options::parser p(&arena);
+    ict::options::pmr::vector<ict::options::pmr::suboptions<opcja1>> subparam(p,"s","sub","","Opis subparam");
+    std::vector<std::string> a({"test","-s","ala=foo,kota=alfa","--sub=ma"});
+    out=testProcess(p,a);
+    if (!out) if (subparam.value.size()!=2) out=101;
+    if (!out) if (subparam.value.get_allocator().resource()!=&arena) out=102;
+    if (!out) if (subparam.value.at(0).get_allocator().resource()!=&arena) out=103;
+    if (!out) if (subparam.value.at(0).size()!=2) out=104;
+    if (!out) if (subparam.value.at(0).at("kota")!="alfa") out=105;
+    if (!out) if (subparam.value.at(0).at("kota").get_allocator().resource()!=&arena) out=106;
+    if (!out) if (subparam.value.at(1).count("ma")!=1) out=107;
+    return(out);
+}
+REGISTER_TEST(suboptions,tc7){
+    int out=0;
+    const static std::string opcja("jeden,dwa trzy");
+    ict::options::suboptions<opcja> o;
+    ict::options::suboptions_t m;
+    if (&ict::options::suboptions<opcja>::getTable()!=&ict::options::suboptions<opcja>::getTable()) out=101;
+    if (!out) if (ict::options::suboptions<opcja>::getTable().find("trzy")!=2) out=102;
+    if (!out) if (ict::options::suboptions<opcja>::getTable().find("cztery")!=-1) out=103;
+    if (!out) if (o.parse("jeden,cztery=4,dwa=a b,,trzy=x=y")) out=104;
+    if (!out) if (o.size()!=3) out=105;
+    if (!out) if (o.at("jeden")!="") out=106;
+    if (!out) if (o.at("dwa")!="a b") out=107;
+    if (!out) if (o.at("trzy")!="x=y") out=108;
+    if (!out) if (ict::options::convert("dwa=b",o)) out=109;
+    if (!out) if (o.at("dwa")!="b") out=110;
+    if (!out) if (ict::options::subprocess("jeden=1,zero",opcja,m)) out=111;
+    if (!out) if ((m.size()!=1)||(m.at("jeden")!="1")) out=112;
+    if (!out) if (testProcess({"test","-m","ma=z spacja"})) out=113;
+    if (!out) if (subparam1.value.at("ma")!="z spacja") out=114;
+    return(out);
+}
+enum class testMode:int {slow=0,fast=1};
+struct testListen {
+    std::string_view addr="*";
+    int port=0;
+    double ratio=1.0;
+    bool tls=false;
+    testMode mode=testMode::slow;
+};
+static constexpr auto testListenFields=ict::options::fields(
+    ict::options::field<&testListen::addr>("addr"),
+    ict::options::field<&testListen::port>("port"),
+    ict::options::field<&testListen::ratio>("ratio"),
+    ict::options::field<&testListen::tls>("tls"),
+    ict::options::field<&testListen::mode>("mode")
+);
+REGISTER_TEST(suboptions,tc8){
+    int out=0;
+    ict::options::parser p;
+    ict::options::single<ict::options::substruct<testListen,testListenFields>> listen(p,"l","listen","port=80","Opis listen");
+    std::vector<std::string> a({"test","-l","addr=::1,port=8080,,tls,mode=1,ratio=0.5"});
+    out=testProcess(p,a);
+    if (!out) if (listen.value.addr!="::1") out=101;
+    if (!out) if (listen.value.addr.data()!=(a[2].data()+5)) out=102;
+    if (!out) if (listen.value.port!=8080) out=103;
+    if (!out) if (listen.value.ratio!=0.5) out=104;
+    if (!out) if (!listen.value.tls) out=105;
+    if (!out) if (listen.value.mode!=testMode::fast) out=106;
+    if (!out) if (testProcess(p,{"test"})) out=107;
+    if (!out) if ((listen.value.addr!="*")||(listen.value.port!=80)||listen.value.tls||(listen.value.mode!=testMode::slow)) out=108;
+    if (!out) if (listen.value.parse("tls=off,port=1")||listen.value.tls||(listen.value.port!=1)) out=109;
+    if (!out) if (listen.value.parse("port=x")!=-1) out=110;
+    if (!out) if (listen.value.parse("tls=maybe")!=-1) out=111;
+    if (!out) if (listen.value.parse("unknown=1")!=-1) out=112;
+    a[2]="port=99999999999";
+    if (!out) if (testProcess(p,a)!=-3) out=113;
+    return(out);
+}
+REGISTER_TEST(suboptions,tc9){
+    int out=0;
+    const static std::string opcja("a,b,c,d,e,f,g,h,i,j");
+    ict::options::parser p;
+    ict::options::single<ict::options::flat_suboptions<opcja1>> flat1(p,"f","flat","ala=nic","Opis flat1");
+    ict::options::vector<ict::options::flat_suboptions<opcja1>> flat2(p,"g","flatv","","Opis flat2");
+    ict::options::flat_suboptions<opcja> o;
+    std::vector<std::string> a({"test","-f","kota=alfa,ma,xyz=1,ala=beta","-g","ma=1","-g","kota=2,ala=3"});
+    out=testProcess(p,a);
+    if (!out) if (flat1.value.size()!=3) out=101;
+    if (!out) if (flat1.value.count("ala")!=1) out=102;
+    if (!out) if (flat1.value.at("ala")!="beta") out=103;
+    if (!out) if (flat1.value.at("ma")!="") out=104;
+    if (!out) if (flat1.value.count("xyz")!=0) out=105;
+    if (!out) if ((*flat1.value.begin()).first!="ala") out=106;
+    if (!out) if (flat2.value.size()!=2) out=107;
+    if (!out) if ((flat2.value.at(0).size()!=1)||(flat2.value.at(0).at("ma")!="1")) out=108;
+    if (!out) if ((flat2.value.at(1).size()!=2)||(flat2.value.at(1).at("kota")!="2")) out=109;
+    if (!out) if (testProcess(p,{"test"})) out=110;
+    if (!out) if ((flat1.value.size()!=1)||(flat1.value.at("ala")!="nic")) out=111;
+    if (!out) if (o.parse("j=10,i=9,h=8,g=7,f=6,e=5,d=4,c=3,b=2,a=1,e=55")) out=112;
+    if (!out) if (o.size()!=10) out=113;
+    if (!out) {
+        std::string keys,values;
+        for (const auto & kv : o) {keys+=kv.first;values+=kv.second;values+=',';}
+        if (keys!="abcdefghij") out=114;
+        if (!out) if (values!="1,2,3,4,55,6,7,8,9,10,") out=115;
+    }
+    if (!out) {
+        ict::options::flat_suboptions<opcja> c(o);
+        o.clear();
+        if ((c.size()!=10)||(c.at("j")!="10")||!o.empty()) out=116;
+    }
+    if (!out) try {
+        o.at("a");
+        out=117;
+    } catch (const std::out_of_range &){}
+    if (!out) if (o.parse("a=1,b")||(o.at("b")!="")||(o.at("b").data()==nullptr)) out=118;//Subopcja bez wartości wskazuje na bufor.
+    if (!out) {
+        const std::string_view input("x=1,y");
+        if (ict::options::subscan(input,[&input](const std::string_view & name,const std::string_view & value){
+            return(((name=="y")&&(value.data()!=input.data()+input.size()))?1:0);
+        })) out=119;
+    }
+    return(out);
+}
 #endif
 //===========================================
\ No newline at end of file
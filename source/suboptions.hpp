@@ -38,6 +38,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //============================================
 #include <string>
 #include <map>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+#include <tuple>
+#include <array>
+#include <iterator>
+#include <memory_resource>
 #include <iostream>
 #include <stdexcept>
 #include "options.hpp"
@@ -46,6 +53,210 @@ namespace ict { namespace  options {
 //===========================================
 //! Mapa przechwująca subopcje
 typedef std::map<std::string,std::string> suboptions_t;
+namespace pmr {
+//! Mapa przechwująca subopcje (korzystająca z zasobu pamięci - std::pmr::memory_resource).
+typedef std::pmr::map<std::pmr::string,std::pmr::string> suboptions_t;
+}
+//! Tablica dozwolonych tokenów (nazw subopcji) - budowana raz dla danej listy tokenów.
+class subtokens {
+private:
+    //! Nazwy subopcji.
+    std::vector<std::string> names;
+    //! Indeksy nazw subopcji (klucze wskazują na names).
+    std::unordered_map<std::string_view,std::size_t> index;
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param tokens Lista dozwolonych tokenów (rozdzielonych przecinkami).
+    //! 
+    explicit subtokens(const std::string & tokens);
+    subtokens(const subtokens &)=delete;
+    subtokens & operator=(const subtokens &)=delete;
+    //! 
+    //! @brief Wyszukuje subopcję.
+    //! 
+    //! @param name Nazwa subopcji.
+    //! @return Indeks subopcji (-1 - brak).
+    //! 
+    int find(const std::string_view & name) const {
+        std::unordered_map<std::string_view,std::size_t>::const_iterator it=index.find(name);
+        return((it!=index.cend())?(int)it->second:-1);
+    }
+    //! 
+    //! @brief Zwraca nazwę subopcji.
+    //! 
+    //! @param k Indeks subopcji.
+    //! @return Nazwa subopcji.
+    //! 
+    const std::string & name(std::size_t k) const {return(names.at(k));}
+};
+//! 
+//! @brief Płaski kontener subopcji (alternatywa dla ict::options::suboptions_t).
+//! 
+//! Subopcje są przechowywane w tablicy posortowanej według nazw (pierwsze inlineCapacity w obiekcie), nazwy wskazują 
+//! na tablicę tokenów (ict::options::subtokens), a wartości na kopię wejściowego ciągu znaków (jeden bufor). 
+//! Tablica tokenów musi istnieć dłużej niż kontener (np. ict::options::suboptions::getTable()).
+//! 
+class flat_suboptions_t {
+public:
+    typedef std::string_view key_type;
+    typedef std::string_view mapped_type;
+    typedef std::pair<std::string_view,std::string_view> value_type;
+    typedef std::size_t size_type;
+    //! Liczba subopcji przechowywanych w obiekcie (bez alokacji).
+    static const size_type inlineCapacity=8;
+private:
+    //! Subopcja.
+    struct entry_t {
+        //! Nazwa subopcji (w tablicy tokenów).
+        const std::string * name;
+        //! Początek wartości w buforze.
+        size_type offset;
+        //! Długość wartości.
+        size_type length;
+    };
+    //! Bufor z wartościami subopcji.
+    std::string buffer;
+    //! Subopcje przechowywane w obiekcie.
+    std::array<entry_t,inlineCapacity> local;
+    //! Pozostałe subopcje.
+    std::vector<entry_t> spill;
+    //! Liczba subopcji.
+    size_type length=0;
+    entry_t & entry(size_type k){return((k<inlineCapacity)?local[k]:spill[k-inlineCapacity]);}
+    const entry_t & entry(size_type k) const {return((k<inlineCapacity)?local[k]:spill[k-inlineCapacity]);}
+    //! 
+    //! @brief Wyszukuje subopcję.
+    //! 
+    //! @param key Nazwa subopcji.
+    //! @return Indeks pierwszej subopcji o nazwie nie mniejszej niż key.
+    //! 
+    size_type lower(const std::string_view & key) const {
+        size_type first=0,last=length;
+        while (first<last){
+            size_type middle=first+(last-first)/2;
+            if (std::string_view(*entry(middle).name)<key) first=middle+1; else last=middle;
+        }
+        return(first);
+    }
+public:
+    //! Iterator (zwraca pary nazwa-wartość).
+    class const_iterator {
+    private:
+        const flat_suboptions_t * owner=nullptr;
+        size_type k=0;
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef flat_suboptions_t::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type * pointer;
+        typedef value_type reference;
+        const_iterator(){}
+        const_iterator(const flat_suboptions_t * owner,size_type k):owner(owner),k(k){}
+        value_type operator*() const {return(owner->item(k));}
+        const_iterator & operator++(){k++;return(*this);}
+        const_iterator operator++(int){const_iterator tmp(*this);k++;return(tmp);}
+        bool operator==(const const_iterator & other) const {return(k==other.k);}
+        bool operator!=(const const_iterator & other) const {return(k!=other.k);}
+    };
+    typedef const_iterator iterator;
+    size_type size() const {return(length);}
+    bool empty() const {return(length==0);}
+    const_iterator begin() const {return(const_iterator(this,0));}
+    const_iterator end() const {return(const_iterator(this,length));}
+    //! 
+    //! @brief Zwraca subopcję.
+    //! 
+    //! @param k Indeks subopcji (kolejność według nazw).
+    //! @return Para nazwa-wartość.
+    //! 
+    value_type item(size_type k) const {
+        const entry_t & e(entry(k));
+        return(value_type(*e.name,std::string_view(buffer.data()+e.offset,e.length)));
+    }
+    //! 
+    //! @brief Zwraca liczbę subopcji o podanej nazwie.
+    //! 
+    //! @param key Nazwa subopcji.
+    //! @return 0 lub 1.
+    //! 
+    size_type count(const std::string_view & key) const {
+        size_type k=lower(key);
+        return(((k<length)&&(*entry(k).name==key))?1:0);
+    }
+    //! 
+    //! @brief Zwraca wartość subopcji (wyjątek std::out_of_range, jeśli jej nie ma).
+    //! 
+    //! @param key Nazwa subopcji.
+    //! @return Wartość subopcji.
+    //! 
+    std::string_view at(const std::string_view & key) const {
+        size_type k=lower(key);
+        if ((k>=length)||(*entry(k).name!=key)) throw std::out_of_range("flat_suboptions_t::at");
+        return(item(k).second);
+    }
+    //! Usuwa wszystkie subopcje.
+    void clear(){
+        buffer.clear();
+        spill.clear();
+        length=0;
+    }
+    //! 
+    //! @brief Dodaje wejściowy ciąg znaków do bufora.
+    //! 
+    //! @param input Wejściowy ciąg znaków.
+    //! @return Widok dodanego ciągu znaków (ważny do następnego wywołania).
+    //! 
+    std::string_view store(const std::string_view & input){
+        size_type offset=buffer.size();
+        buffer.append(input.data(),input.size());
+        return(std::string_view(buffer.data()+offset,input.size()));
+    }
+    //! 
+    //! @brief Ustawia wartość subopcji.
+    //! 
+    //! @param name Nazwa subopcji (w tablicy tokenów).
+    //! @param value Wartość subopcji (w buforze - patrz store(); pusta wartość nie musi wskazywać na bufor).
+    //! 
+    void set(const std::string & name,const std::string_view & value){
+        size_type k=lower(name);
+        entry_t e{&name,value.empty()?0:(size_type)(value.data()-buffer.data()),value.size()};
+        if ((k<length)&&(*entry(k).name==name)){
+            entry(k)=e;
+            return;
+        }
+        if (length<inlineCapacity) local[length]=e; else spill.push_back(e);
+        for (size_type i=length;i>k;i--) std::swap(entry(i),entry(i-1));
+        length++;
+    }
+};
+//! 
+//! @brief Przetwarza subopcje (bez kopiowania wejściowego ciągu znaków).
+//! 
+//! Subopcje są rozdzielone przecinkami, każda w postaci 'nazwa=wartość' lub 'nazwa' (jak w getsubopt()).
+//! Subopcje, których nie ma w tablicy tokenów, są pomijane.
+//! 
+//! @param input Wejściowy ciąg znaków.
+//! @param tokens Tablica dozwolonych tokenów.
+//! @param output Lista subopcji.
+//! @return Jeśli:
+//!  @li 0 - wartość ustawiona poprawnie;
+//!  @li -1 - wystąpił błąd.
+//! 
+int subprocess(const std::string_view & input,const subtokens & tokens,suboptions_t & output);
+//! 
+//! @brief Przetwarza subopcje (mapa korzystająca z zasobu pamięci).
+//! 
+//! Patrz ict::options::subprocess()
+//! 
+int subprocess(const std::string_view & input,const subtokens & tokens,pmr::suboptions_t & output);
+//! 
+//! @brief Przetwarza subopcje (płaski kontener - wejściowy ciąg znaków jest kopiowany raz, do bufora kontenera).
+//! 
+//! Patrz ict::options::subprocess()
+//! 
+int subprocess(const std::string_view & input,const subtokens & tokens,flat_suboptions_t & output);
 //! 
 //! @brief Przetwarza subopcje.
 //! 
@@ -57,18 +268,178 @@ typedef std::map<std::string,std::string> suboptions_t;
 //!  @li -1 - wystąpił błąd.
 //! 
 int subprocess(const std::string & input,const std::string & tokens,suboptions_t & output);
-//! Obiekt przechowujący subopcje.
-template <const std::string & Tokens> class suboptions: public suboptions_t{
+//! 
+//! @brief Przetwarza subopcje (mapa korzystająca z zasobu pamięci).
+//! 
+//! Patrz ict::options::subprocess()
+//! 
+int subprocess(const std::string & input,const std::string & tokens,pmr::suboptions_t & output);
+//! 
+//! @brief Obiekt przechowujący subopcje.
+//! 
+//! @tparam Tokens Lista dozwolonych tokenów (rozdzielonych przecinkami).
+//! @tparam Map Mapa przechowująca subopcje (ict::options::suboptions_t, ict::options::pmr::suboptions_t lub ict::options::flat_suboptions_t).
+//! 
+template <const std::string & Tokens,class Map=suboptions_t> class suboptions: public Map{
 public:
+    using Map::Map;
     //! Zwraca listę dozwolonych tokenów.
     const std::string & getTokens(){return Tokens;}
-    friend std::istream &operator>>(std::istream  &input, suboptions<Tokens> & so) {
+    //! Zwraca tablicę dozwolonych tokenów (budowaną raz - przy pierwszym użyciu).
+    static const subtokens & getTable(){
+        static const subtokens table(Tokens);
+        return(table);
+    }
+    //! 
+    //! @brief Przetwarza subopcje (używane przez ict::options::convert() - bez strumienia i kopiowania).
+    //! 
+    //! @param input Wejściowy ciąg znaków.
+    //! @return Patrz ict::options::subprocess()
+    //! 
+    int parse(const std::string_view & input){
+        return(subprocess(input,getTable(),*this));
+    }
+    friend std::istream &operator>>(std::istream  &input, suboptions<Tokens,Map> & so) {
         std::string tmp;
         input>>tmp;
-        if (subprocess(tmp,Tokens,so)) throw std::invalid_argument("suboptions error");
+        if (so.parse(tmp)) throw std::invalid_argument("suboptions error");
         return input;         
     }
 };
+//! 
+//! @brief Wywołuje funkcję dla każdej subopcji (rozdzielonych przecinkami, w postaci 'nazwa=wartość' lub 'nazwa', puste są pomijane).
+//! 
+//! @param input Wejściowy ciąg znaków.
+//! @param f Funkcja wywoływana z parametrami (const std::string_view & name,const std::string_view & value) i zwracająca int.
+//! @return Jeśli:
+//!  @li 0 - wszystkie subopcje przetworzone poprawnie;
+//!  @li wartość różna od 0 zwrócona przez funkcję f (przetwarzanie jest przerywane).
+//! 
+template <class Function> int subscan(const std::string_view & input,Function && f){
+    std::size_t pos=0;
+    while (pos<input.size()){
+        std::size_t end=input.find(',',pos);
+        std::string_view item;
+        std::size_t eq;
+        int out;
+        if (end==std::string_view::npos) end=input.size();
+        item=input.substr(pos,end-pos);
+        pos=end+1;
+        if (item.empty()) continue;
+        eq=item.find('=');
+        //Subopcja bez wartości dostaje pusty widok wskazujący na koniec nazwy (w obrębie wejściowego ciągu znaków).
+        out=f(item.substr(0,eq),(eq!=std::string_view::npos)?item.substr(eq+1):item.substr(item.size()));
+        if (out) return(out);
+    }
+    return(0);
+}
+//! 
+//! @brief Obiekt przechowujący subopcje w płaskim kontenerze (ict::options::flat_suboptions_t).
+//! 
+//! @tparam Tokens Lista dozwolonych tokenów (rozdzielonych przecinkami).
+//! 
+template <const std::string & Tokens> using flat_suboptions=suboptions<Tokens,flat_suboptions_t>;
+//! 
+//! @brief Subopcja powiązana z polem struktury (patrz ict::options::substruct).
+//! 
+//! @tparam Member Wskaźnik do pola struktury.
+//! 
+template <auto Member> struct field;
+template <class Struct,class Type,Type Struct::*Member> struct field<Member>{
+    //! Nazwa subopcji.
+    std::string_view name;
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param name Nazwa subopcji.
+    //! 
+    constexpr explicit field(const std::string_view & name):name(name){}
+    //! 
+    //! @brief Zapisuje wartość subopcji w polu struktury.
+    //! 
+    //! Wartości są konwertowane przez ict::options::convert(). Pole bool przyjmuje: brak wartości, 1, true, yes, on (prawda) 
+    //! oraz 0, false, no, off (fałsz). Pole std::string_view wskazuje na wejściowy ciąg znaków.
+    //! 
+    //! @param s Struktura.
+    //! @param value Wartość subopcji.
+    //! @return Jeśli: 0 - sukces, -1 - niepoprawna wartość.
+    //! 
+    static int decode(Struct & s,const std::string_view & value){
+        Type & target=s.*Member;
+        if constexpr (std::is_same<Type,bool>::value){
+            if (value.empty()||(value=="1")||(value=="true")||(value=="yes")||(value=="on")){
+                target=true;
+            } else if ((value=="0")||(value=="false")||(value=="no")||(value=="off")){
+                target=false;
+            } else {
+                return(-1);
+            }
+            return(0);
+        } else {
+            return(convert(value,target));
+        }
+    }
+};
+//! 
+//! @brief Tworzy listę subopcji powiązanych z polami struktury (patrz ict::options::substruct).
+//! 
+//! @param f Subopcje (ict::options::field).
+//! @return Lista subopcji.
+//! 
+template <class... Fields> constexpr std::tuple<Fields...> fields(Fields... f){
+    return(std::tuple<Fields...>(f...));
+}
+//! 
+//! @brief Subopcje dekodowane bezpośrednio do struktury (bez mapy i ponownej konwersji tekstu).
+//! 
+//! Każda subopcja jest powiązana z polem struktury (ict::options::field). Nieznana subopcja lub niepoprawna wartość 
+//! jest błędem (opcja zwraca błąd -3). Pola, których nie podano, mają wartości domyślne struktury.
+//! 
+//! @tparam Struct Struktura.
+//! @tparam Fields Lista subopcji (ict::options::fields()).
+//! 
+template <class Struct,const auto & Fields> class substruct : public Struct{
+private:
+    //! 
+    //! @brief Zapisuje wartość subopcji w odpowiednim polu.
+    //! 
+    //! @param name Nazwa subopcji.
+    //! @param value Wartość subopcji.
+    //! @return Jeśli: 0 - sukces, -1 - nieznana subopcja lub niepoprawna wartość.
+    //! 
+    int decode(const std::string_view & name,const std::string_view & value){
+        return(std::apply([this,&name,&value](const auto &... f)->int{
+            int out=-1;
+            bool found=false;
+            ((((!found)&&(f.name==name))?(found=true,out=f.decode(*this,value)):0),...);
+            return(out);
+        },Fields));
+    }
+public:
+    //! Przywraca wartości domyślne struktury.
+    void clear(){
+        static_cast<Struct&>(*this)=Struct();
+    }
+    //! 
+    //! @brief Przetwarza subopcje (używane przez ict::options::convert()).
+    //! 
+    //! @param input Wejściowy ciąg znaków.
+    //! @return Jeśli: 0 - sukces, -1 - błąd.
+    //! 
+    int parse(const std::string_view & input){
+        return(subscan(input,[this](const std::string_view & name,const std::string_view & value){
+            return(decode(name,value));
+        }));
+    }
+};
+namespace pmr {
+//! 
+//! @brief Obiekt przechowujący subopcje w mapie korzystającej z zasobu pamięci.
+//! 
+//! Jako wartość opcji ict::options::pmr::vector korzysta z zasobu pamięci kontekstu parsera.
+//! 
+template <const std::string & Tokens> using suboptions=ict::options::suboptions<Tokens,suboptions_t>;
+}
 //===========================================
 } }
 //============================================
@@ -0,0 +1,70 @@
+//! @file
+//! @brief Test helpers - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @version 1.0
+//! @date 2021
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2021, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _ICT_TESTING_HEADER
+#define _ICT_TESTING_HEADER
+#ifdef ENABLE_TESTING
+//============================================
+#include <string>
+#include <vector>
+#include "options.hpp"
+//============================================
+//! 
+//! @brief Wywołuje process() dla podanych argumentów (do użycia w testach).
+//! 
+//! Elementy argv wskazują na elementy args, więc widoki wartości opcji (std::string_view) są ważne, dopóki istnieje args.
+//! 
+//! @param p Obiekt z metodą process() (kontekst parsera, ict::options::compiled, zestaw opcji).
+//! @param args Argumenty (pierwszy to nazwa programu).
+//! @return Wynik funkcji process().
+//! 
+template <class Parser> int testProcess(Parser & p,std::vector<std::string> & args){
+    std::vector<char*> v;
+    for (auto & s : args) v.push_back(&s[0]);
+    v.push_back(nullptr);
+    return(p.process(args.size(),&v[0]));
+}
+//! Wywołuje process() dla kopii podanych argumentów.
+template <class Parser> int testProcess(Parser & p,const std::vector<std::string> & input){
+    std::vector<std::string> a(input);
+    return(testProcess(p,a));
+}
+//! Wywołuje process() w kontekście domyślnym (ict::options::defaultParser()).
+inline int testProcess(const std::vector<std::string> & input){
+    return(testProcess(ict::options::defaultParser(),input));
+}
+//============================================
+#endif
+#endif